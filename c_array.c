@@ -0,0 +1,241 @@
+/**
+ * c_array.c
+ *
+ * concurrent append-only version of the d_array, for several threads filling one
+ * array at once without a lock. elements live in segments that double in size and
+ * never move; an append reserves its index with an atomic fetch-add and the first
+ * thread to need a segment installs it with a compare-and-swap. see c_array.h.
+ *
+ * source file that contains function definitions.
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "c_array.h"
+
+// returns nonzero if ca is a pointer type (its elements own memory)
+#define C_ARRAY__IS_PTR(ca) (*((ca)->t__ + strlen((ca)->t__) - 1) == '*')
+
+// returns the index of the highest set bit of the nonzero j
+static unsigned c_array__log2(size_t j) {
+#if defined(__GNUC__)
+    return (unsigned) (8 * sizeof(unsigned long long) - 1 -
+		       __builtin_clzll((unsigned long long) j));
+#else
+    unsigned l = 0;
+    while (j >>= 1) {
+	l++;
+    }
+    return l;
+#endif
+}
+
+// sets *s to the segment holding index i of ca and returns the offset of i in it.
+// segments 0 to s - 1 hold b_siz * (2^s - 1) elements, so s = log2(i / b_siz + 1).
+static size_t c_array__locate(c_array *ca, size_t i, unsigned *s) {
+    *s = c_array__log2((i >> ca->b_log) + 1);
+    return i - ((((size_t) 1 << *s) - 1) << ca->b_log);
+}
+
+// returns segment s of ca, allocating and installing it first if no thread has yet.
+// if two threads race to install it, the loser frees its copy and uses the winner's.
+static char *c_array__seg(c_array *ca, unsigned s, const char *fn) {
+    void *p, *q;
+    // if s is past the last segment, print error and exit
+    if (s >= C_ARRAY__SEGS) {
+	fprintf(stderr, "%s: c_array at %p is full\n", fn, (void *) ca);
+	exit(1);
+    }
+    p = atomic_load_explicit(&ca->seg[s], memory_order_acquire);
+    if (p != NULL) {
+	return (char *) p;
+    }
+    q = malloc((ca->b_siz << s) * ca->e_siz);
+    // if q is NULL, print error and exit
+    if (q == NULL) {
+	fprintf(stderr, "%s: malloc error when allocating segment %u of c_array at %p\n",
+		fn, s, (void *) ca);
+	exit(2);
+    }
+    // p is NULL here; on failure it is set to the segment installed by another thread
+    if (atomic_compare_exchange_strong_explicit(&ca->seg[s], &p, q, memory_order_acq_rel,
+						memory_order_acquire)) {
+	return (char *) q;
+    }
+    free(q);
+    return (char *) p;
+}
+
+// creates a new c_array with the same arguments as d_array__new
+c_array *c_array__new(size_t n, size_t e, char *(*__tef)(const void *), const char *__t,
+		      char __sep, char __pr_c, char __ps_c) {
+    // if n < 1, print error and exit
+    if (n < 1) {
+	fprintf(stderr,
+		"%s: number of starting elements must be positive\n", C_ARRAY__NEW_N);
+	exit(1);
+    }
+    // if e < 1, print error and exit
+    if (e < 1) {
+	fprintf(stderr, "%s: size of element must be positive\n", C_ARRAY__NEW_N);
+	exit(1);
+    }
+    // if __t is NULL, print error and exit
+    if (__t == NULL) {
+	fprintf(stderr, "%s: cannot pass NULL as a type\n", C_ARRAY__NEW_N);
+	exit(1);
+    }
+    c_array *ca = (c_array *) malloc(sizeof(c_array));
+    // if ca is NULL, print error and exit
+    if (ca == NULL) {
+	fprintf(stderr, "%s: malloc error when allocating c_array\n", C_ARRAY__NEW_N);
+	exit(2);
+    }
+    unsigned s;
+    atomic_init(&ca->siz, 0);
+    for (s = 0; s < C_ARRAY__SEGS; s++) {
+	atomic_init(&ca->seg[s], NULL);
+    }
+    ca->e_siz = e;
+    // round n up to a power of 2
+    ca->b_log = c_array__log2(n);
+    if (((size_t) 1 << ca->b_log) < n) {
+	ca->b_log++;
+    }
+    ca->b_siz = (size_t) 1 << ca->b_log;
+    ca->__tostr_el = __tef;
+    ca->t__ = (char *) __t;
+    ca->__sep = __sep;
+    ca->__pr_c = __pr_c;
+    ca->__ps_c = __ps_c;
+    c_array__seg(ca, 0, C_ARRAY__NEW_N);
+    return ca;
+}
+
+// appends ca->e_siz bytes from e to ca and returns the index of the new element
+size_t c_array__append(c_array *ca, const void *e) {
+    // if ca or e is NULL, print error and exit
+    if (ca == NULL || e == NULL) {
+	fprintf(stderr, "%s: cannot append null element or onto null c_array\n",
+		C_ARRAY__APPEND_N);
+	exit(1);
+    }
+    size_t i, o;
+    unsigned s;
+    // the only point of contention between threads
+    i = atomic_fetch_add_explicit(&ca->siz, 1, memory_order_relaxed);
+    o = c_array__locate(ca, i, &s);
+    memcpy(c_array__seg(ca, s, C_ARRAY__APPEND_N) + o * ca->e_siz, e, ca->e_siz);
+    return i;
+}
+
+// appends the n elements at e to ca as one block of consecutive indices
+size_t c_array__append_n(c_array *ca, const void *e, size_t n) {
+    // if ca is NULL, or e is NULL while n > 0, print error and exit
+    if (ca == NULL || (e == NULL && n > 0)) {
+	fprintf(stderr, "%s: cannot append null elements or onto null c_array\n",
+		C_ARRAY__APPEND_N_N);
+	exit(1);
+    }
+    // first index, index and offset of the next element to copy, no. elements copied
+    // into the current segment
+    size_t i_0, i, o, n_c;
+    unsigned s;
+    const char *ce = (const char *) e;
+    i_0 = atomic_fetch_add_explicit(&ca->siz, n, memory_order_relaxed);
+    // copy the block one segment at a time
+    for (i = i_0; i < i_0 + n; i += n_c) {
+	o = c_array__locate(ca, i, &s);
+	n_c = (ca->b_siz << s) - o;
+	if (n_c > i_0 + n - i) {
+	    n_c = i_0 + n - i;
+	}
+	memcpy(c_array__seg(ca, s, C_ARRAY__APPEND_N_N) + o * ca->e_siz,
+	       ce + (i - i_0) * ca->e_siz, n_c * ca->e_siz);
+    }
+    return i_0;
+}
+
+// returns the no. indices reserved in ca so far
+size_t c_array__size(c_array *ca) {
+    return atomic_load_explicit(&ca->siz, memory_order_relaxed);
+}
+
+// returns a void * to the element of ca at index i
+void *c_array__get(c_array *ca, size_t i) {
+    // if ca is NULL or i is not a reserved index, print error and exit
+    if (ca == NULL || i >= c_array__size(ca)) {
+	fprintf(stderr, "%s: cannot retrieve data outside of defined bounds of c_array "
+		"at %p\n", C_ARRAY__GET_N, (void *) ca);
+	exit(1);
+    }
+    size_t o;
+    unsigned s;
+    o = c_array__locate(ca, i, &s);
+    return (char *) atomic_load_explicit(&ca->seg[s], memory_order_acquire) + o * ca->e_siz;
+}
+
+// turns ca into a new d_array with the same elements in index order, and frees ca
+d_array *c_array__seal(c_array *ca) {
+    // if ca is NULL, print error and exit
+    if (ca == NULL) {
+	fprintf(stderr, "%s: cannot seal null c_array\n", C_ARRAY__SEAL_N);
+	exit(1);
+    }
+    d_array *da;
+    size_t n, i, n_c;
+    unsigned s;
+    void *p;
+    n = c_array__size(ca);
+    da = d_array__new((n > 0) ? n : AUTO_SIZ, ca->e_siz, ca->__tostr_el, ca->t__,
+		      ca->__sep, ca->__pr_c, ca->__ps_c);
+    // copy whole segments; the last one may be partly filled
+    for (s = 0, i = 0; s < C_ARRAY__SEGS; s++) {
+	p = atomic_load_explicit(&ca->seg[s], memory_order_acquire);
+	if (p == NULL) {
+	    continue;
+	}
+	if (i < n) {
+	    n_c = ca->b_siz << s;
+	    if (n_c > n - i) {
+		n_c = n - i;
+	    }
+	    d_array__append_n(da, p, n_c);
+	    i += n_c;
+	}
+	free(p);
+    }
+    free(ca);
+    return da;
+}
+
+// frees a c_array, along with the memory pointed to by each element if the c_array is a
+// pointer type
+void c_array__free(c_array *ca) {
+    // if ca is NULL, print error and exit
+    if (ca == NULL) {
+	fprintf(stderr, "%s: cannot free null pointer\n", C_ARRAY__FREE_N);
+	exit(1);
+    }
+    size_t i, n;
+    unsigned s;
+    if (C_ARRAY__IS_PTR(ca)) {
+	n = c_array__size(ca);
+	for (i = 0; i < n; i++) {
+	    free(*((void **) c_array__get(ca, i)));
+	}
+    }
+    for (s = 0; s < C_ARRAY__SEGS; s++) {
+	free(atomic_load_explicit(&ca->seg[s], memory_order_relaxed));
+    }
+    free(ca);
+}
@@ -0,0 +1,96 @@
+/**
+ * c_array.h
+ *
+ * concurrent append-only version of the d_array, for several threads filling one
+ * array at once without a lock. a c_array holds the same kind of elements as a d_array
+ * (so the D_ARRAY__* type macros work with c_array__new), but in segments: segment s
+ * holds b_siz * 2^s elements, so segments 0 to s hold b_siz * (2^(s + 1) - 1) elements
+ * and the segment and offset of any index take a few shifts to find. an append
+ * reserves its index with one atomic fetch-add, the thread that first needs a segment
+ * allocates it and installs it with a compare-and-swap, and the element is copied in
+ * without any lock. segments never move once installed, so there is no realloc that a
+ * reader could see half done, and a pointer to an element stays valid until the
+ * c_array is sealed or freed.
+ *
+ * when all appends are done (ex. all producer threads have been joined),
+ * c_array__seal turns the c_array into an ordinary contiguous d_array.
+ *
+ * an element may be read (with c_array__get) once the append that wrote it has
+ * returned, and that return is ordered before the read, ex. because the reader is the
+ * thread that appended it, or has joined that thread. c_array__size is the no. indices
+ * reserved so far, which may include elements that are still being written.
+ *
+ * header file that contains declarations for functions, macros, and the struct.
+ *
+ * sample usage:
+ *
+ * // in each of several threads, with c_array *ca shared between them
+ * for (i = 0; i < 1000; i++) {
+ *     c_array__append(ca, &i);
+ * }
+ * // after joining the threads
+ * d_array *da = c_array__seal(ca);
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#ifndef C_ARRAY_H
+#define C_ARRAY_H
+// include stddef.h for size_t
+#include <stddef.h>
+#include <stdatomic.h>
+// for d_array, D_ARRAY__* type macros, AUTO_SIZ and DEFAULT_SIZ
+#include "d_array.h"
+// max no. segments; enough for b_siz * (2^48 - 1) elements
+#define C_ARRAY__SEGS 48
+// user function names
+#define C_ARRAY__NEW_N "c_array__new"
+#define C_ARRAY__APPEND_N "c_array__append"
+#define C_ARRAY__APPEND_N_N "c_array__append_n"
+#define C_ARRAY__GET_N "c_array__get"
+#define C_ARRAY__SEAL_N "c_array__seal"
+#define C_ARRAY__FREE_N "c_array__free"
+// struct for concurrent append-only array
+struct c_array {
+    // no. indices reserved by appends
+    atomic_size_t siz;
+    // segments; segment s holds b_siz << s elements, NULL until first needed
+    void *_Atomic seg[C_ARRAY__SEGS];
+    // size of each element, no. elements in segment 0 (a power of 2) and its log2
+    size_t e_siz, b_siz, b_log;
+    // same as in the d_array struct, passed on to the d_array from c_array__seal
+    char *(*__tostr_el)(const void *);
+    char *t__;
+    char __sep, __pr_c, __ps_c;
+};
+typedef struct c_array c_array;
+// creates a new c_array with the same arguments as d_array__new, ex. a c_array of int
+// is c_array__new(DEFAULT_SIZ, D_ARRAY__INT). n is rounded up to a power of 2 and is
+// the size of the first segment, which is allocated right away.
+c_array *c_array__new(size_t n, size_t e, char *(*__tef)(const void *), const char *__t,
+		      char __sep, char __pr_c, char __ps_c);
+// appends ca->e_siz bytes from e to ca and returns the index of the new element. safe
+// to call from any no. of threads at once; the order of elements appended by
+// different threads at the same time is the order in which they reserved indices.
+size_t c_array__append(c_array *ca, const void *e);
+// appends the n elements at e to ca as one block of consecutive indices, and returns
+// the index of the first one. same thread safety as c_array__append.
+size_t c_array__append_n(c_array *ca, const void *e, size_t n);
+// returns the no. indices reserved in ca so far
+size_t c_array__size(c_array *ca);
+// returns a void * to the element of ca at index i, which must have been written
+// (see above). the pointer stays valid until ca is sealed or freed.
+void *c_array__get(c_array *ca, size_t i);
+// turns ca into a new d_array with the same elements in index order, and frees ca. must
+// only be called once all appends have returned, and ca may not be used afterwards.
+d_array *c_array__seal(c_array *ca);
+// frees a c_array, along with the memory pointed to by each element if the c_array is a
+// pointer type. must only be called once all appends have returned.
+void c_array__free(c_array *ca);
+
+#endif /* C_ARRAY_H */
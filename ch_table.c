@@ -0,0 +1,163 @@
+/**
+ * ch_table.c
+ *
+ * concurrent, sharded version of the counted string hash table in strh_table.h. see
+ * ch_table.h for how searches avoid taking locks.
+ *
+ * source file that contains function definitions.
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ch_table.h"
+
+// shard of hash h, from its top sh_log bits
+#define CH_SHARD(ct, h) ((ct)->sh + ((ct)->sh_log > 0 ? (h) >> (64 - (ct)->sh_log) : 0))
+
+// returns a new bucket array of siz empty buckets that replaces old
+static ch_buckets *ch_buckets_new(size_t siz, ch_buckets *old) {
+    ch_buckets *bk = (ch_buckets *) malloc(sizeof(ch_buckets) + siz * sizeof(ch_node *));
+    size_t i;
+    assert(bk != NULL);
+    bk->siz = siz;
+    bk->old = old;
+    for (i = 0; i < siz; i++) {
+        atomic_init(bk->b + i, NULL);
+    }
+    return bk;
+}
+
+// returns the node in the chain at hp holding the n char string s with hash h, or NULL
+static ch_node *ch_find(ch_node *hp, const char *s, size_t n, uint64_t h) {
+    while (hp != NULL && (hp->h != h || hp->k->len != n ||
+                          memcmp(hp->k->str, s, n) != 0)) {
+        hp = hp->next;
+    }
+    return hp;
+}
+
+// doubles the no. buckets of shard sh, which must be locked. the new chains are made
+// of new nodes, since searches may be walking the old ones
+static void ch_shard_grow(ch_shard *sh) {
+    ch_buckets *o_bk = atomic_load_explicit(&sh->bkt, memory_order_relaxed);
+    ch_buckets *bk = ch_buckets_new(2 * o_bk->siz, o_bk);
+    ch_node *hp, *hn;
+    size_t i, j;
+    for (i = 0; i < o_bk->siz; i++) {
+        hp = atomic_load_explicit(o_bk->b + i, memory_order_relaxed);
+        for (; hp != NULL; hp = hp->next) {
+            hn = (ch_node *) d_arena__malloc(sh->ar, sizeof(ch_node));
+            j = hp->h % bk->siz;
+            hn->h = hp->h;
+            hn->k = hp->k;
+            hn->next = atomic_load_explicit(bk->b + j, memory_order_relaxed);
+            atomic_store_explicit(bk->b + j, hn, memory_order_relaxed);
+        }
+    }
+    // publish the new buckets along with everything written to them above
+    atomic_store_explicit(&sh->bkt, bk, memory_order_release);
+}
+
+// return a pointer to a new table with n_sh shards, using h_fnv1a
+ch_table *new_ch_table(int n_sh) {
+    return new_ch_table_hf(n_sh, h_fnv1a);
+}
+// return a pointer to a new table with n_sh shards, using hash function hf
+ch_table *new_ch_table_hf(int n_sh, h_func hf) {
+    assert(n_sh > 0 && hf != NULL);
+    ch_table *ct = (ch_table *) malloc(sizeof(ch_table));
+    assert(ct != NULL);
+    int i;
+    // round n_sh up to a power of 2
+    ct->n_sh = 1;
+    ct->sh_log = 0;
+    while (ct->n_sh < n_sh) {
+        ct->n_sh *= 2;
+        ct->sh_log++;
+    }
+    ct->hf = hf;
+    ct->sh = (ch_shard *) malloc(ct->n_sh * sizeof(ch_shard));
+    assert(ct->sh != NULL);
+    for (i = 0; i < ct->n_sh; i++) {
+        atomic_init(&ct->sh[i].bkt, ch_buckets_new(CH_SHARD_SIZ, NULL));
+        pthread_mutex_init(&ct->sh[i].lock, NULL);
+        ct->sh[i].n = 0;
+        ct->sh[i].ar = d_arena__new(D_ARENA__BLK_SIZ);
+    }
+    return ct;
+}
+// insert a new string into the table; if s is already in the table, its count is
+// incremented
+void ch_table_insert(ch_table *ct, char *s) {
+    size_t n = strlen(s);
+    assert(ct != NULL && n > 0 && n <= UINT32_MAX);
+    uint64_t h = ct->hf(s, n);
+    ch_shard *sh = CH_SHARD(ct, h);
+    pthread_mutex_lock(&sh->lock);
+    // only inserts holding the lock change the buckets, so no ordering is needed
+    ch_buckets *bk = atomic_load_explicit(&sh->bkt, memory_order_relaxed);
+    ch_node *_Atomic *b = bk->b + h % bk->siz;
+    ch_node *hp = ch_find(atomic_load_explicit(b, memory_order_relaxed), s, n, h);
+    // if s is already in the table, count it again
+    if (hp != NULL) {
+        atomic_fetch_add_explicit(&hp->k->cnt, 1, memory_order_relaxed);
+        pthread_mutex_unlock(&sh->lock);
+        return;
+    }
+    // else make a key and node, and link the node in at the head of the chain
+    ch_key *k = (ch_key *) d_arena__malloc(sh->ar, sizeof(ch_key) + n + 1);
+    atomic_init(&k->cnt, 1);
+    k->len = (uint32_t) n;
+    memcpy(k->str, s, n + 1);
+    hp = (ch_node *) d_arena__malloc(sh->ar, sizeof(ch_node));
+    hp->h = h;
+    hp->k = k;
+    hp->next = atomic_load_explicit(b, memory_order_relaxed);
+    // publish the node along with its key
+    atomic_store_explicit(b, hp, memory_order_release);
+    // grow the shard if it is too full
+    if (++sh->n > CH_MAX_LF * bk->siz) {
+        ch_shard_grow(sh);
+    }
+    pthread_mutex_unlock(&sh->lock);
+}
+// search for a string in the table; returns occurrences of s in the table
+int ch_table_nsearch(ch_table *ct, char *s) {
+    size_t n = strlen(s);
+    assert(ct != NULL && n > 0);
+    uint64_t h = ct->hf(s, n);
+    ch_shard *sh = CH_SHARD(ct, h);
+    // acquire pairs with the release stores in ch_table_insert and ch_shard_grow, so
+    // that the buckets and nodes read here are fully written
+    ch_buckets *bk = atomic_load_explicit(&sh->bkt, memory_order_acquire);
+    ch_node *hp = atomic_load_explicit(bk->b + h % bk->siz, memory_order_acquire);
+    hp = ch_find(hp, s, n, h);
+    return (hp == NULL) ? 0 : atomic_load_explicit(&hp->k->cnt, memory_order_relaxed);
+}
+// free a table
+void free_ch_table(ch_table *ct) {
+    assert(ct != NULL);
+    ch_buckets *bk, *o_bk;
+    int i;
+    for (i = 0; i < ct->n_sh; i++) {
+        // free the current bucket array and every one it replaced
+        bk = atomic_load_explicit(&ct->sh[i].bkt, memory_order_relaxed);
+        while (bk != NULL) {
+            o_bk = bk->old;
+            free(bk);
+            bk = o_bk;
+        }
+        pthread_mutex_destroy(&ct->sh[i].lock);
+        d_arena__free(ct->sh[i].ar);
+    }
+    free(ct->sh);
+    free(ct);
+}
@@ -0,0 +1,123 @@
+/**
+ * ch_table.h
+ *
+ * concurrent, sharded version of the counted string hash table in strh_table.h, for
+ * several threads inserting into and searching one table at once. the table is split
+ * into shards, and the top bits of the hash of a string pick its shard. each shard is
+ * a counted hash table with its own mutex, so inserts only wait for inserts of strings
+ * in the same shard.
+ *
+ * searches take no lock. once a node is linked into a chain its string, hash, and
+ * next pointer never change; an insert of a new string links a new node in at the
+ * head of its chain with a single release store, and a count is only changed with an
+ * atomic increment. when a shard grows, it builds a new bucket array with new nodes
+ * pointing to the same strings and counts, and swaps it in with one release store, so
+ * a search sees either the old buckets or the new ones, both of them complete. the old
+ * bucket arrays and nodes are kept until the table is freed, since a search may still
+ * be walking them; this at most doubles the memory used by nodes and buckets.
+ *
+ * ch_table_nsearch may be called at any time, including while other threads are
+ * inserting. it counts every insert of s that happened before the call (ex. inserts
+ * made by the calling thread, or by threads it has joined), and may or may not count
+ * inserts that run at the same time as the call.
+ *
+ * header file that contains declarations for functions, macros, and the structs.
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#ifndef CH_TABLE_H
+#define CH_TABLE_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+// for d_arena
+#include "d_alloc.h"
+// for h_func and h_fnv1a
+#include "strh_table.h"
+
+// default no. shards
+#define CH_SHARDS 64
+// no. buckets each shard starts with
+#define CH_SHARD_SIZ 64
+// max load factor (nodes per bucket) before a shard doubles its no. buckets
+#define CH_MAX_LF 1.0
+// a string and its no. occurrences, shared by all the nodes that point to it
+struct ch_key {
+    // no. times str was inserted
+    atomic_int cnt;
+    // length of str
+    uint32_t len;
+    // the string, with its '\0'
+    char str[];
+};
+typedef struct ch_key ch_key;
+// node of a chain; never changes once linked into a chain
+struct ch_node {
+    // full hash of the string
+    uint64_t h;
+    // the string and its count
+    ch_key *k;
+    // pointer to next ch_node
+    struct ch_node *next;
+};
+typedef struct ch_node ch_node;
+// bucket array of a shard
+struct ch_buckets {
+    // no. buckets
+    size_t siz;
+    // the bucket array that this one replaced, kept until the table is freed
+    struct ch_buckets *old;
+    // heads of the chains
+    ch_node *_Atomic b[];
+};
+typedef struct ch_buckets ch_buckets;
+// shard of a ch_table
+struct ch_shard {
+    // current bucket array; replaced, never changed in place, when the shard grows
+    ch_buckets *_Atomic bkt;
+    // held by inserts
+    pthread_mutex_t lock;
+    // no. distinct strings in the shard
+    size_t n;
+    // arena that the nodes and keys of the shard are allocated from
+    d_arena *ar;
+    // keeps shards that are next to each other off of the same cache line
+    char pad[64];
+};
+typedef struct ch_shard ch_shard;
+// sharded concurrent string hash table
+struct ch_table {
+    // array of shards
+    ch_shard *sh;
+    // no. shards (a power of 2) and its log2
+    int n_sh, sh_log;
+    // hash function used for the table
+    h_func hf;
+};
+typedef struct ch_table ch_table;
+// return a pointer to a new table with n_sh shards, using h_fnv1a. n_sh is rounded up
+// to a power of 2; CH_SHARDS is a reasonable default
+ch_table *new_ch_table(int n_sh);
+// return a pointer to a new table with n_sh shards, using hash function hf. the shard
+// of a string comes from the top bits of its hash and its bucket from the low bits,
+// so hf should mix all 64 bits
+ch_table *new_ch_table_hf(int n_sh, h_func hf);
+// insert a new string into the table; if s is already in the table, its count is
+// incremented. safe to call from any no. of threads at once
+void ch_table_insert(ch_table *ct, char *s);
+// search for a string in the table; returns occurrences of s in the table. takes no
+// lock, and is safe to call from any no. of threads at once, including while other
+// threads call ch_table_insert
+int ch_table_nsearch(ch_table *ct, char *s);
+// free a table; no other thread may be using it
+void free_ch_table(ch_table *ct);
+
+#endif /* CH_TABLE_H */
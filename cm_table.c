@@ -0,0 +1,150 @@
+/**
+ * cm_table.c
+ *
+ * Count-Min Sketch with conservative update and a HyperLogLog distinct count, for
+ * approximate string counts in fixed memory. see cm_table.h for the error bounds.
+ *
+ * source file that contains function definitions.
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cm_table.h"
+
+// counter of row i of cm for the string with hash h. the d indices come from two
+// hashes, h and a remix of h, as h + i * h2 (double hashing), so each string is only
+// hashed once. h2 is odd, so it is never 0 mod w, which would put a string at the
+// same index in every row
+static inline uint32_t *cm_ctr(cm_table *cm, uint64_t h, uint64_t h2, size_t i) {
+    return cm->c + i * cm->w + ((h + i * h2) & (cm->w - 1));
+}
+
+// returns the second hash used by cm_ctr, the murmur3 finalizer of h plus the golden
+// ratio, made odd
+static inline uint64_t cm_h2(uint64_t h) {
+    return h_mix64(h + 0x9e3779b97f4a7c15ULL) | 1;
+}
+
+// return a pointer to a new sketch with d rows of w counters that uses h_fnv1a
+cm_table *new_cm_table(size_t w, size_t d) {
+    return new_cm_table_hf(w, d, CM_HLL_P, h_fnv1a);
+}
+
+// return a pointer to a new sketch with d rows of w counters and 2^p registers that
+// uses hash function hf
+cm_table *new_cm_table_hf(size_t w, size_t d, int p, h_func hf) {
+    assert(w > 0 && d > 0 && p >= 4 && p <= 18 && hf != NULL);
+    cm_table *cm = (cm_table *) malloc(sizeof(cm_table));
+    assert(cm != NULL);
+    for (cm->w = 1; cm->w < w; cm->w *= 2)
+        ;
+    cm->d = d;
+    cm->c = (uint32_t *) calloc(cm->w * d, sizeof(uint32_t));
+    assert(cm->c != NULL);
+    cm->p = p;
+    cm->reg = (uint8_t *) calloc((size_t) 1 << p, 1);
+    assert(cm->reg != NULL);
+    cm->n = 0;
+    cm->hf = hf;
+    return cm;
+}
+
+// insert a string into the sketch. the smallest of the string's counters is found
+// first, then only the counters equal to it are incremented. the string's
+// HyperLogLog register is set to the position of the first 1 bit after the register
+// index bits of the hash, if that is more than the register holds
+void cm_table_insert(cm_table *cm, char *s) {
+    assert(cm != NULL && s != NULL);
+    uint64_t h = cm->hf(s, strlen(s)), h2 = cm_h2(h);
+    uint32_t min = UINT32_MAX, *c;
+    size_t i;
+    for (i = 0; i < cm->d; i++) {
+        c = cm_ctr(cm, h, h2, i);
+        if (*c < min) { min = *c; }
+    }
+    if (min < UINT32_MAX) {
+        for (i = 0; i < cm->d; i++) {
+            c = cm_ctr(cm, h, h2, i);
+            if (*c == min) { (*c)++; }
+        }
+    }
+    // the top p bits pick the register; the set bit stops the count at 64 - p + 1
+    uint64_t r = (h << cm->p) | ((uint64_t) 1 << (cm->p - 1));
+    uint8_t rank = 1;
+    while ((r & ((uint64_t) 1 << 63)) == 0) {
+        r <<= 1;
+        rank++;
+    }
+    if (cm->reg[h >> (64 - cm->p)] < rank) { cm->reg[h >> (64 - cm->p)] = rank; }
+    cm->n++;
+}
+
+// search for a string in the sketch; returns the smallest of its counters
+int cm_table_nsearch(cm_table *cm, char *s) {
+    assert(cm != NULL && s != NULL);
+    uint64_t h = cm->hf(s, strlen(s)), h2 = cm_h2(h);
+    uint32_t min = UINT32_MAX, *c;
+    size_t i;
+    for (i = 0; i < cm->d; i++) {
+        c = cm_ctr(cm, h, h2, i);
+        if (*c < min) { min = *c; }
+    }
+    return (min > INT_MAX) ? INT_MAX : (int) min;
+}
+
+// returns the HyperLogLog estimate of the no. distinct strings inserted: the bias
+// corrected harmonic mean of 2^reg over the m registers, times m. when that is under
+// 2.5m and some registers are still 0, linear counting is more accurate
+double cm_table_ndistinct(cm_table *cm) {
+    assert(cm != NULL);
+    size_t m = (size_t) 1 << cm->p, i, z = 0;
+    double sum = 0, a, e;
+    for (i = 0; i < m; i++) {
+        sum += ldexp(1.0, -cm->reg[i]);
+        if (cm->reg[i] == 0) { z++; }
+    }
+    a = (m == 16) ? 0.673 : (m == 32) ? 0.697 : (m == 64) ? 0.709 :
+        0.7213 / (1.0 + 1.079 / m);
+    e = a * m * m / sum;
+    if (e <= 2.5 * m && z > 0) { e = m * log((double) m / z); }
+    return e;
+}
+
+// adds the counters of src to those of dst (saturating at UINT32_MAX) and sets each
+// register of dst to the larger of the two
+int cm_table_merge(cm_table *dst, cm_table *src) {
+    assert(dst != NULL && src != NULL);
+    size_t i;
+    if (dst->w != src->w || dst->d != src->d || dst->p != src->p || dst->hf != src->hf) {
+        errno = EINVAL;
+        return -1;
+    }
+    for (i = 0; i < dst->w * dst->d; i++) {
+        dst->c[i] = (dst->c[i] > UINT32_MAX - src->c[i]) ? UINT32_MAX :
+            dst->c[i] + src->c[i];
+    }
+    for (i = 0; i < ((size_t) 1 << dst->p); i++) {
+        if (dst->reg[i] < src->reg[i]) { dst->reg[i] = src->reg[i]; }
+    }
+    dst->n += src->n;
+    return 0;
+}
+
+// free a sketch
+void free_cm_table(cm_table *cm) {
+    assert(cm != NULL);
+    free(cm->c);
+    free(cm->reg);
+    free(cm);
+}
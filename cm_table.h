@@ -0,0 +1,99 @@
+/**
+ * cm_table.h
+ *
+ * approximate, fixed-memory counterpart of the counted string hash table in
+ * strh_table.h, for streams with too many distinct strings to keep. a cm_table is a
+ * Count-Min Sketch of the no. times each string was inserted, plus a HyperLogLog
+ * estimate of the no. distinct strings inserted. neither stores any strings, and all
+ * of its memory is allocated by new_cm_table: w * d 32-bit counters and 2^p one byte
+ * registers.
+ *
+ * the sketch has d rows of w counters. inserting a string hashes it to one counter in
+ * each row, and cm_table_nsearch returns the smallest of those d counters. inserts use
+ * conservative update: only the counters that are equal to the current smallest one
+ * are incremented, since the others already count more than the string was inserted.
+ * so for a string inserted c times out of N inserts in all, cm_table_nsearch never
+ * returns less than c, and returns at most c + (e / w) N with probability at least
+ * 1 - e^-d (e = 2.718...). ex. w = 2^16 and d = 4 (1 MiB of counters) overcount by at
+ * most 0.0041% of N for 98% of strings. conservative update only ever makes the
+ * counts lower, and in practice much closer to c than the bound. counters saturate at
+ * UINT32_MAX.
+ *
+ * the HyperLogLog estimate uses 2^p registers and has a standard error of about
+ * 1.04 / sqrt(2^p), ex. 0.81% for p = 14 (16 KiB), with small counts corrected by
+ * linear counting.
+ *
+ * sketches with the same w, d, p, and hash function can be merged with
+ * cm_table_merge, which adds the counters and takes the largest of each register. so
+ * each thread or shard can count its part of a stream in its own cm_table, without
+ * any locks, and the parts merged at the end. the merged counts keep the same bounds
+ * with N the total no. inserts of all the parts.
+ *
+ * header file that contains declarations for functions, macros, and the structs.
+ *
+ * sample usage:
+ *
+ * cm_table *cm = new_cm_table(CM_W, CM_D);
+ * // ...for each string s in the stream...
+ * cm_table_insert(cm, s);
+ * printf("abc: at least %d, distinct: about %.0f\n", cm_table_nsearch(cm, "abc"),
+ *        cm_table_ndistinct(cm));
+ * free_cm_table(cm);
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#ifndef CM_TABLE_H
+#define CM_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+// for h_func and h_fnv1a
+#include "strh_table.h"
+
+// default width (a power of 2) and depth of the sketch, and log2 of the no.
+// HyperLogLog registers
+#define CM_W 65536
+#define CM_D 4
+#define CM_HLL_P 14
+// Count-Min Sketch with a HyperLogLog distinct count
+struct cm_table {
+    // counters, d rows of w each
+    uint32_t *c;
+    // width of each row (a power of 2), depth (no. rows)
+    size_t w, d;
+    // HyperLogLog registers, 2^p of them
+    uint8_t *reg;
+    int p;
+    // no. strings inserted
+    uint64_t n;
+    // hash function used for the table
+    h_func hf;
+};
+typedef struct cm_table cm_table;
+// return a pointer to a new sketch with d rows of w counters (w rounded up to a power
+// of 2) and 2^CM_HLL_P registers that uses h_fnv1a
+cm_table *new_cm_table(size_t w, size_t d);
+// return a pointer to a new sketch with d rows of w counters and 2^p registers, where
+// 4 <= p <= 18, that uses hash function hf
+cm_table *new_cm_table_hf(size_t w, size_t d, int p, h_func hf);
+// insert a string into the sketch, with conservative update
+void cm_table_insert(cm_table *cm, char *s);
+// search for a string in the sketch; returns an estimate of the occurrences of s,
+// which is never less than the true count (see above)
+int cm_table_nsearch(cm_table *cm, char *s);
+// returns the HyperLogLog estimate of the no. distinct strings inserted
+double cm_table_ndistinct(cm_table *cm);
+// adds the counts of src to dst, as if the strings inserted into src had been
+// inserted into dst. returns 0, or -1 with errno set to EINVAL if the two sketches do
+// not have the same w, d, p, and hash function
+int cm_table_merge(cm_table *dst, cm_table *src);
+// free a sketch
+void free_cm_table(cm_table *cm);
+
+#endif /* CM_TABLE_H */
@@ -5,6 +5,40 @@
  *
  * Changelog:
  *
+ * 10-17-2026
+ *
+ * fixed call to d_array__new to match its current signature. added demo of the
+ * d_array range functions to the test area, and added the --bench flag, which runs
+ * all benchmarks (or only the one named after the flag). added benchmark of the
+ * d_array range functions against looped single element inserts and removes. added
+ * benchmark of d_array_int from d_array_t.h against the generic d_array. added demo
+ * and benchmark of d_arrays allocated from a d_arena. added demo of d_array capacity
+ * management and a benchmark of d_array growth policies. added demo of g_array and a
+ * benchmark of front inserts and removes against d_array. added demo and benchmark of
+ * d_array__remove_if and d_array__remove_many. added demo of d_array__write to stdout
+ * and to a fixed buffer, and a benchmark of d_array__write against d_array__tostr and
+ * against the old way of converting each element with a malloc'd string. added demo of
+ * printing long and double d_arrays, and a benchmark of d_fmt against sprintf. added
+ * demo and benchmark of d_array__sort, d_array__sort_mt, and d_array__lower_bound.
+ * added demo of d_array__save and d_array__open_mmap, and a benchmark of loading a
+ * d_array from a text file against opening a saved one. added demo of c_array and a
+ * benchmark of concurrent appends with c_array against a mutex around d_array__append.
+ * the last print loop of the d_array demo uses D_ARRAY__FOREACH. added benchmark of
+ * the checked d_array accessors against the unchecked inline ones and the iterator.
+ * added demo of sh_table, and a benchmark of it against h_table on a strsea-like
+ * workload. added demo and benchmark of h_table growth with incremental rehash. added
+ * demo and benchmark of counted h_tables. added benchmark of h_tables allocating from
+ * arenas. added demo of ch_table, and a benchmark of it against a counted h_table
+ * behind a mutex from 1 to 8 threads. added demo and benchmark of batched h_table
+ * searches. added demo and benchmark of freezing an h_table into an fh_table. added
+ * demo of d_hmap, and a benchmark of it against h_table with string and long keys.
+ * added demo of rx_tree, and a benchmark of its memory use and exact and prefix
+ * searches against h_table. added demo of cm_table, and a benchmark of its speed,
+ * memory, and count errors against h_table. added demo of an h_table with a Bloom
+ * filter, and a benchmark of its searches with and without the filter as the share
+ * of strings that were inserted goes from 0 to 1. added demo of ss_table, and a
+ * benchmark of its top k strings of a skewed stream against a counted h_table.
+ *
  * 11-16-2018
  *
  * added code in test area to reflect changes in sample code of d_array.c
@@ -33,22 +67,1995 @@
 #include <string.h>
 #include <stdlib.h>
 #include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
 
 // current package being tested (update as necessary with correct header file)
 #define CUR_TEST "d_array.h"
 #include CUR_TEST
+#include "d_array_t.h"
+#include "g_array.h"
+#include "d_fmt.h"
+#include "d_mmap.h"
+#include "c_array.h"
+#include "strh_table.h"
+#include "sh_table.h"
+#include "ch_table.h"
+#include "fh_table.h"
+#include "d_hmap.h"
+#include "rx_tree.h"
+#include "cm_table.h"
+#include "ss_table.h"
 
 // program name
 #define PROGNAME "custom_lib_test"
 // help flag
 #define HELP_FLAG "--help"
+// benchmark flag
+#define BENCH_FLAG "--bench"
 
 // help string
-#define HELP_STR "Usage: " PROGNAME " [ " HELP_FLAG " ]\n" \
+#define HELP_STR "Usage: " PROGNAME " [ " HELP_FLAG " | " BENCH_FLAG " [ name ] ]\n" \
     "driver program to test any features in custom_lib.\n\n" \
+    "with " BENCH_FLAG ", runs all benchmarks, or only the benchmark called name.\n" \
+    "recommended to build benchmarks with optimization using 'make bench'.\n\n" \
     "current package being tested: " CUR_TEST "\b\b  "
 // two backspaces move the cursor back before writing whitespace to cover the .h
 
+/*** BENCHMARK AREA ***/
+
+// no. elements in the d_array for d_array benchmarks
+#define BENCH_N 1000000
+// no. elements inserted or removed by the d_array range benchmarks
+#define BENCH_K 1000
+
+// returns current time in seconds from a monotonic clock, for timing benchmarks
+static double bench__now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+// returns a new int d_array holding 0 to n - 1
+static d_array *bench__iota(size_t n) {
+    d_array *da = d_array__new(n, D_ARRAY__INT);
+    int i;
+    for (i = 0; i < (int) n; i++) {
+	d_array__append(da, &i);
+    }
+    return da;
+}
+
+// inserts then removes BENCH_K elements in the middle of a BENCH_N element d_array,
+// once with BENCH_K calls to d_array__insert/d_array__remove and once with a single
+// call to d_array__insert_range/d_array__remove_range
+static void bench__d_array__range(void) {
+    d_array *da, *db;
+    double t0, t_ins, t_ins_r, t_rem, t_rem_r;
+    size_t i, m;
+    int *e;
+    m = BENCH_N / 2;
+    // elements to insert
+    e = (int *) malloc(BENCH_K * sizeof(int));
+    for (i = 0; i < BENCH_K; i++) {
+	e[i] = -((int) i);
+    }
+    da = bench__iota(BENCH_N);
+    db = bench__iota(BENCH_N);
+    // insert in reverse so that da ends up in the same order as db
+    t0 = bench__now();
+    for (i = BENCH_K; i > 0; i--) {
+	d_array__insert(da, e + i - 1, m);
+    }
+    t_ins = bench__now() - t0;
+    t0 = bench__now();
+    d_array__insert_range(db, e, BENCH_K, m);
+    t_ins_r = bench__now() - t0;
+    if (da->siz != db->siz || memcmp(da->a, db->a, da->siz * da->e_siz) != 0) {
+	fprintf(stderr, "%s: d_array__insert_range result differs from d_array__insert\n",
+		PROGNAME);
+	exit(1);
+    }
+    t0 = bench__now();
+    for (i = 0; i < BENCH_K; i++) {
+	d_array__remove(da, m);
+    }
+    t_rem = bench__now() - t0;
+    t0 = bench__now();
+    d_array__remove_range(db, m, m + BENCH_K);
+    t_rem_r = bench__now() - t0;
+    if (da->siz != db->siz || memcmp(da->a, db->a, da->siz * da->e_siz) != 0) {
+	fprintf(stderr, "%s: d_array__remove_range result differs from d_array__remove\n",
+		PROGNAME);
+	exit(1);
+    }
+    printf("insert %d elements at index %lu of %d:\n"
+	   "  d_array__insert       %10.6f s\n"
+	   "  d_array__insert_range %10.6f s (%.1fx)\n",
+	   BENCH_K, (unsigned long) m, BENCH_N, t_ins, t_ins_r, t_ins / t_ins_r);
+    printf("remove %d elements at index %lu of %d:\n"
+	   "  d_array__remove       %10.6f s\n"
+	   "  d_array__remove_range %10.6f s (%.1fx)\n",
+	   BENCH_K, (unsigned long) m, BENCH_N + BENCH_K, t_rem, t_rem_r,
+	   t_rem / t_rem_r);
+    free(e);
+    d_array__free(da);
+    d_array__free(db);
+}
+
+// appends BENCH_N ints, sums them with get, and doubles them with set, using the
+// generic d_array, then d_array_int, then d_array_int with direct access to da->a
+static void bench__d_array_t(void) {
+    d_array *da;
+    d_array_int *dt;
+    double t0, t_app[3], t_get[3], t_set[3];
+    long s[3];
+    int i, k;
+    // generic d_array
+    t0 = bench__now();
+    da = d_array__new(DEFAULT_SIZ, D_ARRAY__INT);
+    for (i = 0; i < BENCH_N; i++) {
+	d_array__append(da, &i);
+    }
+    t_app[0] = bench__now() - t0;
+    t0 = bench__now();
+    s[0] = 0;
+    for (i = 0; i < BENCH_N; i++) {
+	s[0] += *((int *) d_array__get(da, i));
+    }
+    t_get[0] = bench__now() - t0;
+    t0 = bench__now();
+    for (i = 0; i < BENCH_N; i++) {
+	k = 2 * *((int *) d_array__get(da, i));
+	d_array__set(da, i, &k);
+    }
+    t_set[0] = bench__now() - t0;
+    // d_array_int with accessor functions
+    t0 = bench__now();
+    dt = d_array_int__new(DEFAULT_SIZ);
+    for (i = 0; i < BENCH_N; i++) {
+	d_array_int__append(dt, i);
+    }
+    t_app[1] = bench__now() - t0;
+    t0 = bench__now();
+    s[1] = 0;
+    for (i = 0; i < BENCH_N; i++) {
+	s[1] += *d_array_int__get(dt, i);
+    }
+    t_get[1] = bench__now() - t0;
+    t0 = bench__now();
+    for (i = 0; i < BENCH_N; i++) {
+	d_array_int__set(dt, i, 2 * *d_array_int__get(dt, i));
+    }
+    t_set[1] = bench__now() - t0;
+    // d_array_int with loops directly over dt->a, which the compiler can vectorize
+    d_array_int__remove_range(ALL__(dt));
+    t0 = bench__now();
+    for (i = 0; i < BENCH_N; i++) {
+	d_array_int__append(dt, i);
+    }
+    t_app[2] = bench__now() - t0;
+    t0 = bench__now();
+    s[2] = 0;
+    for (i = 0; i < (int) dt->siz; i++) {
+	s[2] += dt->a[i];
+    }
+    t_get[2] = bench__now() - t0;
+    t0 = bench__now();
+    for (i = 0; i < (int) dt->siz; i++) {
+	dt->a[i] = 2 * dt->a[i];
+    }
+    t_set[2] = bench__now() - t0;
+    if (s[0] != s[1] || s[0] != s[2] || memcmp(da->a, dt->a, BENCH_N * sizeof(int)) != 0) {
+	fprintf(stderr, "%s: d_array_int results differ from d_array\n", PROGNAME);
+	exit(1);
+    }
+    printf("%d ints          %12s %12s %12s\n", BENCH_N, "append", "get (sum)", "set (x2)");
+    printf("  d_array          %10.6f s %10.6f s %10.6f s\n", t_app[0], t_get[0], t_set[0]);
+    for (k = 1; k < 3; k++) {
+	printf("  %-16s %10.6f s %10.6f s %10.6f s (%.1fx, %.1fx, %.1fx)\n",
+	       (k == 1) ? "d_array_int" : "d_array_int->a", t_app[k], t_get[k], t_set[k],
+	       t_app[0] / t_app[k], t_get[0] / t_get[k], t_set[0] / t_set[k]);
+    }
+    d_array__free(da);
+    d_array_int__free(dt);
+}
+
+// sums BENCH_N ints and doubles them, using the checked d_array__get and d_array__set,
+// the unchecked d_array__get_u and d_array__set_u, and D_ARRAY__FOREACH
+static void bench__d_array__get_u(void) {
+    d_array *da;
+    double t0, t_get[3], t_set[3];
+    long s[3];
+    size_t i;
+    int k;
+    da = bench__iota(BENCH_N);
+    t0 = bench__now();
+    s[0] = 0;
+    for (i = 0; i < da->siz; i++) {
+	s[0] += *((int *) d_array__get(da, i));
+    }
+    t_get[0] = bench__now() - t0;
+    t0 = bench__now();
+    for (i = 0; i < da->siz; i++) {
+	k = 2 * *((int *) d_array__get(da, i));
+	d_array__set(da, i, &k);
+    }
+    t_set[0] = bench__now() - t0;
+    t0 = bench__now();
+    s[1] = 0;
+    for (i = 0; i < da->siz; i++) {
+	s[1] += *((int *) d_array__get_u(da, i));
+    }
+    t_get[1] = bench__now() - t0;
+    t0 = bench__now();
+    for (i = 0; i < da->siz; i++) {
+	k = 2 * *((int *) d_array__get_u(da, i));
+	d_array__set_u(da, i, &k);
+    }
+    t_set[1] = bench__now() - t0;
+    t0 = bench__now();
+    s[2] = 0;
+    D_ARRAY__FOREACH(int, p, da) {
+	s[2] += *p;
+    }
+    t_get[2] = bench__now() - t0;
+    t0 = bench__now();
+    D_ARRAY__FOREACH(int, p, da) {
+	*p = 2 * *p;
+    }
+    t_set[2] = bench__now() - t0;
+    // the elements were doubled 3 times
+    if (s[0] != s[1] / 2 || s[0] != s[2] / 4 || *((int *) d_array__get_u(da, 1)) != 8) {
+	fprintf(stderr, "%s: unchecked accessor results differ\n", PROGNAME);
+	exit(1);
+    }
+    printf("%d ints            %12s %12s\n", BENCH_N, "get (sum)", "set (x2)");
+    printf("  d_array__get/set     %10.6f s %10.6f s\n", t_get[0], t_set[0]);
+    for (k = 1; k < 3; k++) {
+	printf("  %-20s %10.6f s %10.6f s (%.1fx, %.1fx)\n",
+	       (k == 1) ? "d_array__get_u/set_u" : "D_ARRAY__FOREACH", t_get[k],
+	       t_set[k], t_get[0] / t_get[k], t_set[0] / t_set[k]);
+    }
+    d_array__free(da);
+}
+
+// no. simulated requests and temporary d_arrays per request for the d_arena benchmark
+#define BENCH_REQS 1000
+#define BENCH_REQ_ARRAYS 100
+// no. ints appended to each temporary d_array
+#define BENCH_REQ_ELEMS 50
+
+// for each of BENCH_REQS simulated requests, creates BENCH_REQ_ARRAYS d_arrays of
+// AUTO_SIZ capacity, appends BENCH_REQ_ELEMS ints to each, and releases all of them,
+// once using malloc and d_array__free, and once using a d_arena and d_arena__reset
+static void bench__d_arena(void) {
+    d_array *das[BENCH_REQ_ARRAYS];
+    d_arena *ar;
+    double t0, t_std, t_ar;
+    long s_std, s_ar;
+    int r, i, j;
+    s_std = s_ar = 0;
+    t0 = bench__now();
+    for (r = 0; r < BENCH_REQS; r++) {
+	for (i = 0; i < BENCH_REQ_ARRAYS; i++) {
+	    das[i] = d_array__new(AUTO_SIZ, D_ARRAY__INT);
+	    for (j = 0; j < BENCH_REQ_ELEMS; j++) {
+		d_array__append(das[i], &j);
+	    }
+	    s_std += das[i]->siz;
+	}
+	for (i = 0; i < BENCH_REQ_ARRAYS; i++) {
+	    d_array__free(das[i]);
+	}
+    }
+    t_std = bench__now() - t0;
+    t0 = bench__now();
+    ar = d_arena__new(D_ARENA__BLK_SIZ);
+    for (r = 0; r < BENCH_REQS; r++) {
+	for (i = 0; i < BENCH_REQ_ARRAYS; i++) {
+	    das[i] = d_array__new_with_alloc(AUTO_SIZ, D_ARRAY__INT, d_arena__al(ar));
+	    for (j = 0; j < BENCH_REQ_ELEMS; j++) {
+		d_array__append(das[i], &j);
+	    }
+	    s_ar += das[i]->siz;
+	}
+	d_arena__reset(ar);
+    }
+    d_arena__free(ar);
+    t_ar = bench__now() - t0;
+    if (s_std != s_ar) {
+	fprintf(stderr, "%s: d_arena d_arrays differ from malloc d_arrays\n", PROGNAME);
+	exit(1);
+    }
+    printf("%d requests, each with %d d_arrays of %d ints:\n"
+	   "  malloc + d_array__free %10.6f s\n"
+	   "  d_arena + d_arena__reset %8.6f s (%.1fx)\n",
+	   BENCH_REQS, BENCH_REQ_ARRAYS, BENCH_REQ_ELEMS, t_std, t_ar, t_std / t_ar);
+}
+
+// no. append/remove cycles and elements per cycle for the growth policy benchmark
+#define BENCH_CYCLES 100000
+#define BENCH_CYCLE_ELEMS 64
+
+// runs BENCH_CYCLES cycles of appending BENCH_CYCLE_ELEMS ints to an empty d_array and
+// then removing them again from the end, with the default growth policy, with the
+// no-shrink policy, and with the default policy after reserving BENCH_CYCLE_ELEMS (which
+// does not help much, since the default policy shrinks the reserved space away)
+static void bench__d_array__policy(void) {
+    const char *names[3] = {"default", "no shrink", "reserve"};
+    d_array *da;
+    double t0, t;
+    int c, i, k;
+    printf("%d cycles of %d appends then %d removes:\n", BENCH_CYCLES,
+	   BENCH_CYCLE_ELEMS, BENCH_CYCLE_ELEMS);
+    for (k = 0; k < 3; k++) {
+	da = d_array__new(AUTO_SIZ, D_ARRAY__INT);
+	if (k == 1) {
+	    d_array__set_policy(da, D_ARRAY__POLICY__NO_SHRINK);
+	}
+	else if (k == 2) {
+	    d_array__reserve(da, BENCH_CYCLE_ELEMS);
+	}
+	t0 = bench__now();
+	for (c = 0; c < BENCH_CYCLES; c++) {
+	    for (i = 0; i < BENCH_CYCLE_ELEMS; i++) {
+		d_array__append(da, &i);
+	    }
+	    for (i = 0; i < BENCH_CYCLE_ELEMS; i++) {
+		d_array__remove(da, da->siz - 1);
+	    }
+	}
+	t = bench__now() - t0;
+	printf("  %-10s %10.6f s, n_realloc %8lu, b_moved %10lu, max_siz %lu\n", names[k],
+	       t, (unsigned long) da->n_realloc, (unsigned long) da->b_moved,
+	       (unsigned long) da->max_siz);
+	d_array__free(da);
+    }
+}
+
+// no. elements initially in the arrays for the g_array benchmark, no. elements
+// inserted and then removed at the front
+#define BENCH_G_N 100000
+#define BENCH_G_K 10000
+
+// starting with BENCH_G_N ints, inserts BENCH_G_K ints at index 0 and then removes
+// them again from index 0, using a d_array and then a g_array
+static void bench__g_array(void) {
+    d_array *da;
+    g_array *ga;
+    double t0, t_da[2], t_ga[2];
+    int i;
+    da = bench__iota(BENCH_G_N);
+    ga = g_array__new(BENCH_G_N, D_ARRAY__INT);
+    for (i = 0; i < BENCH_G_N; i++) {
+	g_array__append(ga, &i);
+    }
+    t0 = bench__now();
+    for (i = 0; i < BENCH_G_K; i++) {
+	d_array__insert(da, &i, 0);
+    }
+    t_da[0] = bench__now() - t0;
+    t0 = bench__now();
+    for (i = 0; i < BENCH_G_K; i++) {
+	g_array__insert(ga, &i, 0);
+    }
+    t_ga[0] = bench__now() - t0;
+    for (i = 0; i < BENCH_G_N + BENCH_G_K; i++) {
+	if (*((int *) d_array__get(da, i)) != *((int *) g_array__get(ga, i))) {
+	    fprintf(stderr, "%s: g_array differs from d_array at index %d\n", PROGNAME, i);
+	    exit(1);
+	}
+    }
+    t0 = bench__now();
+    for (i = 0; i < BENCH_G_K; i++) {
+	d_array__remove(da, 0);
+    }
+    t_da[1] = bench__now() - t0;
+    t0 = bench__now();
+    for (i = 0; i < BENCH_G_K; i++) {
+	g_array__remove(ga, 0);
+    }
+    t_ga[1] = bench__now() - t0;
+    printf("%d inserts, then %d removes, at index 0 of %d ints:\n"
+	   "  d_array %10.6f s %10.6f s\n"
+	   "  g_array %10.6f s %10.6f s (%.1fx, %.1fx)\n", BENCH_G_K, BENCH_G_K, BENCH_G_N,
+	   t_da[0], t_da[1], t_ga[0], t_ga[1], t_da[0] / t_ga[0], t_da[1] / t_ga[1]);
+    d_array__free(da);
+    g_array__free(ga);
+}
+
+// no. elements in the d_array for the compaction benchmark, and the stride of the
+// elements that get removed
+#define BENCH_RM_N 100000
+#define BENCH_RM_STRIDE 10
+
+// predicate for d_array__remove_if; true if the int at e is a multiple of *ctx
+static int bench__is_mult(const void *e, void *ctx) {
+    return *((const int *) e) % *((int *) ctx) == 0;
+}
+
+// removes every BENCH_RM_STRIDE-th element from a BENCH_RM_N element d_array, using
+// repeated d_array__remove, d_array__remove_if, and d_array__remove_many
+static void bench__d_array__remove_if(void) {
+    d_array *da[3];
+    size_t *idx, n_idx, i;
+    double t0, t[3];
+    int k, m;
+    m = BENCH_RM_STRIDE;
+    n_idx = (BENCH_RM_N + BENCH_RM_STRIDE - 1) / BENCH_RM_STRIDE;
+    idx = (size_t *) malloc(n_idx * sizeof(size_t));
+    for (i = 0; i < n_idx; i++) {
+	idx[i] = i * BENCH_RM_STRIDE;
+    }
+    for (k = 0; k < 3; k++) {
+	da[k] = bench__iota(BENCH_RM_N);
+    }
+    // remove from the back so that the remaining indices stay valid
+    t0 = bench__now();
+    for (i = n_idx; i > 0; i--) {
+	d_array__remove(da[0], idx[i - 1]);
+    }
+    t[0] = bench__now() - t0;
+    t0 = bench__now();
+    d_array__remove_if(da[1], bench__is_mult, &m);
+    t[1] = bench__now() - t0;
+    t0 = bench__now();
+    d_array__remove_many(da[2], idx, n_idx);
+    t[2] = bench__now() - t0;
+    for (k = 1; k < 3; k++) {
+	if (da[k]->siz != da[0]->siz ||
+	    memcmp(da[k]->a, da[0]->a, da[0]->siz * da[0]->e_siz) != 0) {
+	    fprintf(stderr, "%s: compaction result differs from d_array__remove\n",
+		    PROGNAME);
+	    exit(1);
+	}
+    }
+    printf("remove every %d-th of %d ints (%lu removes):\n"
+	   "  d_array__remove      %10.6f s\n"
+	   "  d_array__remove_if   %10.6f s (%.1fx)\n"
+	   "  d_array__remove_many %10.6f s (%.1fx)\n", BENCH_RM_STRIDE, BENCH_RM_N,
+	   (unsigned long) n_idx, t[0], t[1], t[0] / t[1], t[2], t[0] / t[2]);
+    for (k = 0; k < 3; k++) {
+	d_array__free(da[k]);
+    }
+    free(idx);
+}
+
+// no. elements written by the d_array__write benchmark
+#define BENCH_WR_N 1000000
+
+// d_writer callback that only counts the chars it is given; ctx is the size_t count
+static size_t bench__count_f(void *ctx, const char *s, size_t n) {
+    *((size_t *) ctx) += n;
+    return n;
+}
+
+// writes a BENCH_WR_N element d_array of int as a string: element by element with
+// __tostr_el__int and a growing string, as d_array__tostr did before d_array__write,
+// with d_array__tostr, and with d_array__write to a writer that discards the output
+// and to /dev/null (if it can be opened)
+static void bench__d_array__write(void) {
+    d_array *da;
+    d_writer w;
+    FILE *f;
+    char *s, *ce;
+    size_t i, n_s, max_s, n_c, l_ce;
+    double t0, t[4];
+    int k;
+    // use values with a realistic mix of lengths and signs
+    da = d_array__new(BENCH_WR_N, D_ARRAY__INT);
+    for (i = 0; i < BENCH_WR_N; i++) {
+	k = (int) ((i * 2654435761u) % 2000001) - 1000000;
+	d_array__append(da, &k);
+    }
+    // old: a malloc'd string for each element, copied into a growing string
+    t0 = bench__now();
+    max_s = BUFSIZ;
+    s = (char *) malloc(max_s);
+    n_s = 0;
+    for (i = 0; i < da->siz; i++) {
+	ce = __tostr_el__int((char *) da->a + i * da->e_siz);
+	l_ce = strlen(ce);
+	if (n_s + l_ce + 2 > max_s) {
+	    max_s = 2 * max_s;
+	    s = (char *) realloc(s, max_s);
+	}
+	memcpy(s + n_s, ce, l_ce);
+	n_s += l_ce;
+	s[n_s++] = ' ';
+	free(ce);
+    }
+    t[0] = bench__now() - t0;
+    free(s);
+    t0 = bench__now();
+    s = d_array__tostr(ALL__(da));
+    t[1] = bench__now() - t0;
+    n_s = strlen(s);
+    free(s);
+    n_c = 0;
+    w.write_f = bench__count_f;
+    w.ctx = (void *) &n_c;
+    t0 = bench__now();
+    d_array__write(ALL__(da), &w);
+    t[2] = bench__now() - t0;
+    if (n_c != n_s) {
+	fprintf(stderr, "%s: d_array__write wrote %lu chars, d_array__tostr %lu\n",
+		PROGNAME, (unsigned long) n_c, (unsigned long) n_s);
+	exit(1);
+    }
+    t[3] = 0;
+    f = fopen("/dev/null", "w");
+    if (f != NULL) {
+	w = d_writer__file(f);
+	t0 = bench__now();
+	d_array__write(ALL__(da), &w);
+	t[3] = bench__now() - t0;
+	fclose(f);
+    }
+    printf("write %d ints as a string (%lu chars):\n"
+	   "  __tostr_el__int per element  %10.6f s\n"
+	   "  d_array__tostr               %10.6f s (%.1fx)\n"
+	   "  d_array__write, no output    %10.6f s (%.1fx)\n"
+	   "  d_array__write to /dev/null  %10.6f s (%.1fx)\n", BENCH_WR_N,
+	   (unsigned long) n_s, t[0], t[1], t[0] / t[1], t[2], t[0] / t[2], t[3],
+	   (t[3] > 0) ? t[0] / t[3] : 0.0);
+    d_array__free(da);
+}
+
+// no. numbers formatted by the d_fmt benchmark
+#define BENCH_FMT_N 1000000
+
+// formats BENCH_FMT_N longs and doubles with sprintf and with d_fmt. the doubles are
+// formatted with %.17g, the shortest printf format that always reads back as the same
+// double, and with %g, which usually does not; d_fmt__dtoa output is checked to read
+// back exactly.
+static void bench__d_fmt(void) {
+    long *l;
+    double *d, t0, t[5];
+    char b[D_FMT__BUF_SIZ + 1];
+    size_t i, n_c[5], n;
+    l = (long *) malloc(BENCH_FMT_N * sizeof(long));
+    d = (double *) malloc(BENCH_FMT_N * sizeof(double));
+    for (i = 0; i < BENCH_FMT_N; i++) {
+	l[i] = (long) (i * 2654435761u) - (long) (i * 40503u) * (long) (i % 1000);
+	d[i] = (double) l[i] / (double) (i % 997 + 1);
+    }
+    memset(n_c, 0, sizeof(n_c));
+    t0 = bench__now();
+    for (i = 0; i < BENCH_FMT_N; i++) {
+	n_c[0] += (size_t) sprintf(b, "%ld", l[i]);
+    }
+    t[0] = bench__now() - t0;
+    t0 = bench__now();
+    for (i = 0; i < BENCH_FMT_N; i++) {
+	n_c[1] += d_fmt__ltoa(b, l[i]);
+    }
+    t[1] = bench__now() - t0;
+    t0 = bench__now();
+    for (i = 0; i < BENCH_FMT_N; i++) {
+	n_c[2] += (size_t) sprintf(b, "%.17g", d[i]);
+    }
+    t[2] = bench__now() - t0;
+    t0 = bench__now();
+    for (i = 0; i < BENCH_FMT_N; i++) {
+	n_c[3] += (size_t) sprintf(b, "%g", d[i]);
+    }
+    t[3] = bench__now() - t0;
+    t0 = bench__now();
+    for (i = 0; i < BENCH_FMT_N; i++) {
+	n_c[4] += d_fmt__dtoa(b, d[i]);
+    }
+    t[4] = bench__now() - t0;
+    if (n_c[0] != n_c[1]) {
+	fprintf(stderr, "%s: d_fmt__ltoa and sprintf wrote different no. chars\n",
+		PROGNAME);
+	exit(1);
+    }
+    for (i = 0; i < BENCH_FMT_N; i++) {
+	n = d_fmt__dtoa(b, d[i]);
+	b[n] = '\0';
+	if (strtod(b, NULL) != d[i]) {
+	    fprintf(stderr, "%s: d_fmt__dtoa wrote %s for %.17g\n", PROGNAME, b, d[i]);
+	    exit(1);
+	}
+    }
+    printf("format %d numbers:\n"
+	   "  long,   sprintf %%ld     %10.6f s\n"
+	   "  long,   d_fmt__ltoa     %10.6f s (%.1fx)\n"
+	   "  double, sprintf %%.17g   %10.6f s (%lu chars)\n"
+	   "  double, sprintf %%g      %10.6f s (%lu chars, does not round trip)\n"
+	   "  double, d_fmt__dtoa     %10.6f s (%lu chars, %.1fx vs %%.17g)\n",
+	   BENCH_FMT_N, t[0], t[1], t[0] / t[1], t[2], (unsigned long) n_c[2], t[3],
+	   (unsigned long) n_c[3], t[4], (unsigned long) n_c[4], t[2] / t[4]);
+    free(l);
+    free(d);
+}
+
+// no. elements sorted by the sort benchmark, no. lookups, no. threads for
+// d_array__sort_mt
+#define BENCH_SORT_N 1000000
+#define BENCH_SORT_Q 1000000
+#define BENCH_SORT_THR 4
+
+// qsort comparators for int and double
+static int bench__cmp_int(const void *a, const void *b) {
+    int x = *((const int *) a), y = *((const int *) b);
+    return (x > y) - (x < y);
+}
+static int bench__cmp_double(const void *a, const void *b) {
+    double x = *((const double *) a), y = *((const double *) b);
+    return (x > y) - (x < y);
+}
+
+// sorts BENCH_SORT_N random ints and doubles with qsort on a copy of the elements (the
+// old way), d_array__sort with a comparator, d_array__sort without one (radix sort),
+// and d_array__sort_mt with BENCH_SORT_THR threads. then looks up BENCH_SORT_Q keys in
+// the sorted ints with d_array__lower_bound, with and without a comparator.
+static void bench__d_array__sort(void) {
+    d_array *da[2][4];
+    void *c;
+    size_t i, q, s_q[2];
+    double t0, t[2][4], t_q[2], v_d;
+    int k, m, v_i;
+    unsigned long r;
+    const char *t_n[2] = {"int", "double"};
+    // same random values in all four d_arrays of each type
+    for (m = 0; m < 4; m++) {
+	da[0][m] = d_array__new(BENCH_SORT_N, D_ARRAY__INT);
+	da[1][m] = d_array__new(BENCH_SORT_N, D_ARRAY__DOUBLE);
+	r = 1;
+	for (i = 0; i < BENCH_SORT_N; i++) {
+	    r = r * 6364136223846793005UL + 1442695040888963407UL;
+	    v_i = (int) (r >> 32);
+	    v_d = (double) (long) r / 1e9;
+	    d_array__append(da[0][m], &v_i);
+	    d_array__append(da[1][m], &v_d);
+	}
+    }
+    for (k = 0; k < 2; k++) {
+	int (*cmp)(const void *, const void *);
+	cmp = (k == 0) ? bench__cmp_int : bench__cmp_double;
+	// old: copy out to a raw array, qsort, copy back
+	t0 = bench__now();
+	c = malloc(BENCH_SORT_N * da[k][0]->e_siz);
+	memcpy(c, da[k][0]->a, BENCH_SORT_N * da[k][0]->e_siz);
+	qsort(c, BENCH_SORT_N, da[k][0]->e_siz, cmp);
+	memcpy(da[k][0]->a, c, BENCH_SORT_N * da[k][0]->e_siz);
+	free(c);
+	t[k][0] = bench__now() - t0;
+	t0 = bench__now();
+	d_array__sort(da[k][1], cmp);
+	t[k][1] = bench__now() - t0;
+	t0 = bench__now();
+	d_array__sort(da[k][2], NULL);
+	t[k][2] = bench__now() - t0;
+	t0 = bench__now();
+	d_array__sort_mt(da[k][3], NULL, BENCH_SORT_THR);
+	t[k][3] = bench__now() - t0;
+	for (m = 1; m < 4; m++) {
+	    if (memcmp(da[k][m]->a, da[k][0]->a, BENCH_SORT_N * da[k][0]->e_siz) != 0) {
+		fprintf(stderr, "%s: sorted %s d_arrays differ\n", PROGNAME, t_n[k]);
+		exit(1);
+	    }
+	}
+	printf("sort %d random %ss:\n"
+	       "  qsort on a copy                %10.6f s\n"
+	       "  d_array__sort, comparator      %10.6f s (%.1fx)\n"
+	       "  d_array__sort, radix           %10.6f s (%.1fx)\n"
+	       "  d_array__sort_mt, %d threads    %10.6f s (%.1fx)\n", BENCH_SORT_N,
+	       t_n[k], t[k][0], t[k][1], t[k][0] / t[k][1], t[k][2], t[k][0] / t[k][2],
+	       BENCH_SORT_THR, t[k][3], t[k][0] / t[k][3]);
+    }
+    // look up every element and as many random keys, with and without a comparator
+    for (m = 0; m < 2; m++) {
+	s_q[m] = 0;
+	r = 7;
+	t0 = bench__now();
+	for (q = 0; q < BENCH_SORT_Q; q++) {
+	    r = r * 6364136223846793005UL + 1442695040888963407UL;
+	    v_i = (q % 2 == 0) ? ((int *) da[0][0]->a)[(r >> 33) % BENCH_SORT_N] :
+		(int) (r >> 32);
+	    s_q[m] += d_array__lower_bound(da[0][0], &v_i, (m == 0) ? bench__cmp_int : NULL);
+	}
+	t_q[m] = bench__now() - t0;
+    }
+    if (s_q[0] != s_q[1]) {
+	fprintf(stderr, "%s: d_array__lower_bound results differ\n", PROGNAME);
+	exit(1);
+    }
+    printf("%d lookups in %d sorted ints:\n"
+	   "  d_array__lower_bound, comparator %10.6f s\n"
+	   "  d_array__lower_bound, direct     %10.6f s (%.1fx)\n", BENCH_SORT_Q,
+	   BENCH_SORT_N, t_q[0], t_q[1], t_q[0] / t_q[1]);
+    for (k = 0; k < 2; k++) {
+	for (m = 0; m < 4; m++) {
+	    d_array__free(da[k][m]);
+	}
+    }
+}
+
+// no. elements in the smallest d_array of the d_mmap benchmark (which uses 100 and
+// 10000 times as many too), and the file names it uses
+#define BENCH_MMAP_N 1000
+#define BENCH_MMAP_TXT "/tmp/" PROGNAME "_bench.txt"
+#define BENCH_MMAP_BIN "/tmp/" PROGNAME "_bench.bin"
+
+// loads a d_array of ints saved as text and as a d_array file, for d_arrays of
+// increasing size. the text is read in one fread and parsed with strtol, which is the
+// fastest a text load can be; the d_array file is opened with d_array__open_mmap, once
+// only opened and once opened and summed, which touches every page.
+static void bench__d_mmap(void) {
+    d_array *da;
+    d_writer w;
+    FILE *f;
+    char *b, *p, *q;
+    size_t n, i, l_b;
+    double t0, t[3];
+    long sum[2];
+    int k;
+    for (n = BENCH_MMAP_N; n <= 10000 * BENCH_MMAP_N; n = 100 * n) {
+	da = bench__iota(n);
+	f = fopen(BENCH_MMAP_TXT, "w");
+	if (f == NULL || d_array__save(da, BENCH_MMAP_BIN) != 0) {
+	    perror(PROGNAME);
+	    exit(1);
+	}
+	w = d_writer__file(f);
+	d_array__write(ALL__(da), &w);
+	fclose(f);
+	d_array__free(da);
+	// text: read, parse, and append every element
+	t0 = bench__now();
+	f = fopen(BENCH_MMAP_TXT, "r");
+	fseek(f, 0, SEEK_END);
+	l_b = (size_t) ftell(f);
+	rewind(f);
+	b = (char *) malloc(l_b + 1);
+	l_b = fread(b, 1, l_b, f);
+	b[l_b] = '\0';
+	fclose(f);
+	da = d_array__new(DEFAULT_SIZ, D_ARRAY__INT);
+	// skip the '[' of the d_array__tostr format
+	for (p = b + 1; ; p = q) {
+	    k = (int) strtol(p, &q, 10);
+	    if (q == p) {
+		break;
+	    }
+	    d_array__append(da, &k);
+	}
+	free(b);
+	t[0] = bench__now() - t0;
+	sum[0] = 0;
+	for (i = 0; i < da->siz; i++) {
+	    sum[0] += ((int *) da->a)[i];
+	}
+	d_array__free(da);
+	// d_array file: open only, then open and sum
+	t0 = bench__now();
+	da = d_array__open_mmap(BENCH_MMAP_BIN, D_ARRAY__MMAP_RDONLY);
+	t[1] = bench__now() - t0;
+	d_array__free(da);
+	t0 = bench__now();
+	da = d_array__open_mmap(BENCH_MMAP_BIN, D_ARRAY__MMAP_RDONLY);
+	sum[1] = 0;
+	for (i = 0; i < da->siz; i++) {
+	    sum[1] += ((int *) da->a)[i];
+	}
+	t[2] = bench__now() - t0;
+	if (da->siz != n || sum[0] != sum[1]) {
+	    fprintf(stderr, "%s: text and d_array file hold different elements\n",
+		    PROGNAME);
+	    exit(1);
+	}
+	d_array__free(da);
+	printf("load %lu ints:\n"
+	       "  parse text              %10.6f s\n"
+	       "  d_array__open_mmap      %10.6f s (%.1fx)\n"
+	       "  open_mmap and read all  %10.6f s (%.1fx)\n", (unsigned long) n, t[0],
+	       t[1], t[0] / t[1], t[2], t[0] / t[2]);
+    }
+    remove(BENCH_MMAP_TXT);
+    remove(BENCH_MMAP_BIN);
+}
+
+// total no. elements appended by the threads of the c_array benchmark, and the most
+// threads it uses
+#define BENCH_CA_N 4000000
+#define BENCH_CA_THR 8
+
+// shared state of the threads of the c_array benchmark
+struct bench__ca {
+    // d_array and the mutex that guards it, or c_array
+    d_array *da;
+    pthread_mutex_t mtx;
+    c_array *ca;
+    // no. elements each thread appends
+    size_t n;
+};
+
+// appends n ints to da, locking the mutex around each d_array__append
+static void *bench__ca_mutex_f(void *arg) {
+    struct bench__ca *b = (struct bench__ca *) arg;
+    size_t i;
+    int k;
+    for (i = 0; i < b->n; i++) {
+	k = (int) i;
+	pthread_mutex_lock(&b->mtx);
+	d_array__append(b->da, &k);
+	pthread_mutex_unlock(&b->mtx);
+    }
+    return NULL;
+}
+
+// appends n ints to ca without a lock
+static void *bench__ca_atomic_f(void *arg) {
+    struct bench__ca *b = (struct bench__ca *) arg;
+    size_t i;
+    int k;
+    for (i = 0; i < b->n; i++) {
+	k = (int) i;
+	c_array__append(b->ca, &k);
+    }
+    return NULL;
+}
+
+// runs f on n_thr threads with the shared state b, and returns the time taken
+static double bench__ca_run(void *(*f)(void *), struct bench__ca *b, int n_thr) {
+    pthread_t th[BENCH_CA_THR];
+    double t0;
+    int i;
+    t0 = bench__now();
+    for (i = 0; i < n_thr; i++) {
+	if (pthread_create(th + i, NULL, f, b) != 0) {
+	    fprintf(stderr, "%s: cannot create thread\n", PROGNAME);
+	    exit(1);
+	}
+    }
+    for (i = 0; i < n_thr; i++) {
+	pthread_join(th[i], NULL);
+    }
+    return bench__now() - t0;
+}
+
+// has 1, 2, 4, ..., BENCH_CA_THR threads append BENCH_CA_N ints in total to one d_array
+// guarded by a mutex, and to one c_array, which is then sealed
+static void bench__c_array(void) {
+    struct bench__ca b;
+    double t[3];
+    int n_thr;
+    pthread_mutex_init(&b.mtx, NULL);
+    printf("append %d ints from n threads (Mops/s):\n"
+	   "  threads  mutex + d_array  c_array  (speedup)  c_array__seal\n", BENCH_CA_N);
+    for (n_thr = 1; n_thr <= BENCH_CA_THR; n_thr = 2 * n_thr) {
+	b.n = BENCH_CA_N / n_thr;
+	b.da = d_array__new(DEFAULT_SIZ, D_ARRAY__INT);
+	t[0] = bench__ca_run(bench__ca_mutex_f, &b, n_thr);
+	b.ca = c_array__new(DEFAULT_SIZ, D_ARRAY__INT);
+	t[1] = bench__ca_run(bench__ca_atomic_f, &b, n_thr);
+	t[2] = bench__now();
+	d_array *da = c_array__seal(b.ca);
+	t[2] = bench__now() - t[2];
+	if (da->siz != b.da->siz) {
+	    fprintf(stderr, "%s: c_array and d_array sizes differ\n", PROGNAME);
+	    exit(1);
+	}
+	printf("  %7d  %15.1f  %7.1f  (%6.1fx)  %10.6f s\n", n_thr,
+	       b.da->siz / t[0] / 1e6, da->siz / t[1] / 1e6, t[0] / t[1], t[2]);
+	d_array__free(da);
+	d_array__free(b.da);
+    }
+    pthread_mutex_destroy(&b.mtx);
+}
+
+// longest string in the string hash table benchmarks, like the strsea input
+#define BENCH_STR_LEN 20
+// strsea-like workload: n_ins strings picked at random from n_w distinct strings are
+// inserted, then n_qry strings are searched for, a fraction of which were inserted
+struct bench__strs {
+    // distinct strings, inserted strings, query strings
+    char **w, **ins, **qry;
+    size_t n_w, n_ins, n_qry;
+    // every string allocated for the workload, so they can be freed
+    char **pool;
+    size_t n_pool;
+};
+
+// returns a new string of 1 to BENCH_STR_LEN random lowercase letters
+static char *bench__word(void) {
+    size_t i, n = 1 + (size_t) rand() % BENCH_STR_LEN;
+    char *s = (char *) malloc(n + 1);
+    for (i = 0; i < n; i++) {
+	s[i] = 'a' + rand() % 26;
+    }
+    s[n] = '\0';
+    return s;
+}
+
+// fills b with n_ins inserts picked from n_w distinct strings, and n_qry queries, of
+// which a fraction hit are picked from the inserted strings and the rest are new
+static void bench__strs_new(struct bench__strs *b, size_t n_w, size_t n_ins,
+			    size_t n_qry, double hit) {
+    size_t i;
+    b->n_w = n_w;
+    b->n_ins = n_ins;
+    b->n_qry = n_qry;
+    b->w = (char **) malloc(n_w * sizeof(char *));
+    b->ins = (char **) malloc(n_ins * sizeof(char *));
+    b->qry = (char **) malloc(n_qry * sizeof(char *));
+    b->pool = (char **) malloc((n_w + n_qry) * sizeof(char *));
+    b->n_pool = 0;
+    for (i = 0; i < n_w; i++) {
+	b->w[i] = b->pool[b->n_pool++] = bench__word();
+    }
+    for (i = 0; i < n_ins; i++) {
+	b->ins[i] = b->w[(size_t) rand() % n_w];
+    }
+    for (i = 0; i < n_qry; i++) {
+	if ((double) rand() / RAND_MAX < hit) {
+	    b->qry[i] = b->ins[(size_t) rand() % n_ins];
+	}
+	else {
+	    b->qry[i] = b->pool[b->n_pool++] = bench__word();
+	}
+    }
+}
+
+// frees the strings and arrays of b
+static void bench__strs_free(struct bench__strs *b) {
+    size_t i;
+    for (i = 0; i < b->n_pool; i++) {
+	free(b->pool[i]);
+    }
+    free(b->pool);
+    free(b->w);
+    free(b->ins);
+    free(b->qry);
+}
+
+// string hash table workloads: strsea input size, repeated, and a larger one. half the
+// queries hit
+#define BENCH_SH_REPS 1000
+#define BENCH_SH_W 20000
+#define BENCH_SH_N 200000
+
+// inserts and searches the strings of b reps times with an h_table of siz buckets, or
+// with a sh_table if siz is 0. t[0] and t[1] get the insert and search times, and the
+// sum of the search results is returned
+static long bench__sh_run(struct bench__strs *b, int reps, int siz, double *t) {
+    long sum = 0;
+    size_t i;
+    int r;
+    double t0;
+    t[0] = t[1] = 0;
+    for (r = 0; r < reps; r++) {
+	h_table *ht = NULL;
+	sh_table *st = NULL;
+	t0 = bench__now();
+	if (siz > 0) {
+	    ht = new_h_table(siz);
+	    for (i = 0; i < b->n_ins; i++) { h_table_insert(ht, b->ins[i]); }
+	}
+	else {
+	    st = new_sh_table(0);
+	    for (i = 0; i < b->n_ins; i++) { sh_table_insert(st, b->ins[i]); }
+	}
+	t[0] += bench__now() - t0;
+	t0 = bench__now();
+	if (siz > 0) {
+	    for (i = 0; i < b->n_qry; i++) { sum += h_table_nsearch(ht, b->qry[i]); }
+	    free_h_table(ht);
+	}
+	else {
+	    for (i = 0; i < b->n_qry; i++) { sum += sh_table_nsearch(st, b->qry[i]); }
+	    free_sh_table(st);
+	}
+	t[1] += bench__now() - t0;
+    }
+    return sum;
+}
+
+// strsea workload with the chained h_table (H_SIZ buckets, and as many buckets as
+// distinct strings) against the open addressing sh_table, which starts empty and grows
+static void bench__sh_table(void) {
+    struct bench__strs b;
+    double t[3][2];
+    long sum[3];
+    int k, reps;
+    srand(1);
+    printf("insert, then search (half hits), Mops/s:\n"
+	   "                        h_table (H_SIZ)  h_table (siz = distinct)  sh_table\n");
+    for (k = 0; k < 2; k++) {
+	if (k == 0) {
+	    bench__strs_new(&b, 100, 1000, 1000, 0.5);
+	    reps = BENCH_SH_REPS;
+	}
+	else {
+	    bench__strs_new(&b, BENCH_SH_W, BENCH_SH_N, BENCH_SH_N, 0.5);
+	    reps = 1;
+	}
+	sum[0] = bench__sh_run(&b, reps, H_SIZ, t[0]);
+	sum[1] = bench__sh_run(&b, reps, (int) b.n_w, t[1]);
+	sum[2] = bench__sh_run(&b, reps, 0, t[2]);
+	if (sum[0] != sum[1] || sum[0] != sum[2]) {
+	    fprintf(stderr, "%s: h_table and sh_table search results differ\n", PROGNAME);
+	    exit(1);
+	}
+	printf("  %lu of %lu distinct:\n", (unsigned long) b.n_ins, (unsigned long) b.n_w);
+	printf("    insert  %23.2f  %24.2f  %8.2f\n", reps * b.n_ins / t[0][0] / 1e6,
+	       reps * b.n_ins / t[1][0] / 1e6, reps * b.n_ins / t[2][0] / 1e6);
+	printf("    search  %23.2f  %24.2f  %8.2f\n", reps * b.n_qry / t[0][1] / 1e6,
+	       reps * b.n_qry / t[1][1] / 1e6, reps * b.n_qry / t[2][1] / 1e6);
+	bench__strs_free(&b);
+    }
+}
+
+// no. strings inserted by the h_table growth benchmark
+#define BENCH_HG_N 200000
+
+// inserts BENCH_HG_N new strings into an h_table with H_SIZ buckets that is fixed
+// (max load factor 0), that grows with an incremental rehash, and that grows with the
+// whole rehash done by the insert that starts it, then searches for each string
+static void bench__h_table_grow(void) {
+    const char *names[3] = {"fixed", "incremental", "all at once"};
+    struct bench__strs b;
+    double t0, t1, t_ins, t_max, t_sea;
+    long sum;
+    size_t i;
+    int k;
+    srand(1);
+    bench__strs_new(&b, BENCH_HG_N, BENCH_HG_N, 0, 0);
+    printf("insert %d strings into h_table starting at %d buckets:\n"
+	   "  rehash       buckets  insert (s)  max insert (ms)  search (Mops/s)\n",
+	   BENCH_HG_N, H_SIZ);
+    for (k = 0; k < 3; k++) {
+	h_table *ht = new_h_table(H_SIZ);
+	if (k == 0) {
+	    h_table_set_max_lf(ht, 0);
+	}
+	t_max = 0;
+	t_ins = bench__now();
+	for (i = 0; i < b.n_w; i++) {
+	    t0 = bench__now();
+	    h_table_insert(ht, b.w[i]);
+	    if (k == 2) {
+		h_table_rehash(ht);
+	    }
+	    t1 = bench__now() - t0;
+	    t_max = (t1 > t_max) ? t1 : t_max;
+	}
+	t_ins = bench__now() - t_ins;
+	sum = 0;
+	t_sea = bench__now();
+	for (i = 0; i < b.n_w; i++) {
+	    sum += h_table_nsearch(ht, b.w[i]);
+	}
+	t_sea = bench__now() - t_sea;
+	if (sum < (long) b.n_w) {
+	    fprintf(stderr, "%s: h_table lost strings\n", PROGNAME);
+	    exit(1);
+	}
+	printf("  %-11s  %7d  %10.3f  %15.3f  %15.2f\n", names[k], ht->siz, t_ins,
+	       t_max * 1e3, b.n_w / t_sea / 1e6);
+	free_h_table(ht);
+    }
+    bench__strs_free(&b);
+}
+
+// no. strings inserted and distinct strings in the counted h_table benchmark
+#define BENCH_HC_N 200000
+#define BENCH_HC_W 2000
+
+// inserts BENCH_HC_N strings picked from BENCH_HC_W distinct strings into an h_table
+// and a counted h_table, then searches for as many strings, half of them inserted
+static void bench__h_table_counted(void) {
+    const char *names[2] = {"node per insert", "counted"};
+    struct bench__strs b;
+    double t_ins, t_sea;
+    long sum[2];
+    size_t i;
+    int k;
+    srand(1);
+    bench__strs_new(&b, BENCH_HC_W, BENCH_HC_N, BENCH_HC_N, 0.5);
+    printf("insert %d strings (%d distinct), then search (half hits):\n"
+	   "  h_table           nodes  memory (MB)  insert (Mops/s)  search (Mops/s)\n",
+	   BENCH_HC_N, BENCH_HC_W);
+    for (k = 0; k < 2; k++) {
+	h_table *ht = new_h_table_hf(H_SIZ, h_fnv1a, (k == 1) ? H_COUNTED : 0);
+	t_ins = bench__now();
+	for (i = 0; i < b.n_ins; i++) {
+	    h_table_insert(ht, b.ins[i]);
+	}
+	t_ins = bench__now() - t_ins;
+	sum[k] = 0;
+	t_sea = bench__now();
+	for (i = 0; i < b.n_qry; i++) {
+	    sum[k] += h_table_nsearch(ht, b.qry[i]);
+	}
+	t_sea = bench__now() - t_sea;
+	printf("  %-15s  %7lu  %11.1f  %15.2f  %15.2f\n", names[k],
+	       (unsigned long) ht->n, h_table_mem(ht) / 1e6, b.n_ins / t_ins / 1e6,
+	       b.n_qry / t_sea / 1e6);
+	free_h_table(ht);
+    }
+    if (sum[0] != sum[1]) {
+	fprintf(stderr, "%s: counted h_table search results differ\n", PROGNAME);
+	exit(1);
+    }
+    bench__strs_free(&b);
+}
+
+// no. strings inserted by the h_table arena benchmark
+#define BENCH_HA_N 1000000
+
+// inserts BENCH_HA_N new strings into a counted h_table with nodes and strings from
+// malloc and from arenas, searches for each, then frees the table
+static void bench__h_table_arena(void) {
+    const char *names[2] = {"malloc", "H_ARENA"};
+    struct bench__strs b;
+    double t[3];
+    long sum;
+    size_t i;
+    int k;
+    srand(1);
+    bench__strs_new(&b, BENCH_HA_N, BENCH_HA_N, 0, 0);
+    printf("%d strings in a counted h_table (s):\n"
+	   "  nodes     insert  search    free\n", BENCH_HA_N);
+    for (k = 0; k < 2; k++) {
+	t[0] = bench__now();
+	h_table *ht = new_h_table_hf(H_SIZ, h_fnv1a, H_COUNTED | ((k == 1) ? H_ARENA : 0));
+	for (i = 0; i < b.n_w; i++) {
+	    h_table_insert(ht, b.w[i]);
+	}
+	t[0] = bench__now() - t[0];
+	sum = 0;
+	t[1] = bench__now();
+	for (i = 0; i < b.n_w; i++) {
+	    sum += h_table_nsearch(ht, b.w[i]);
+	}
+	t[1] = bench__now() - t[1];
+	t[2] = bench__now();
+	free_h_table(ht);
+	t[2] = bench__now() - t[2];
+	if (sum < (long) b.n_w) {
+	    fprintf(stderr, "%s: h_table lost strings\n", PROGNAME);
+	    exit(1);
+	}
+	printf("  %-7s  %6.3f  %6.3f  %6.3f\n", names[k], t[0], t[1], t[2]);
+    }
+    bench__strs_free(&b);
+}
+
+// strings inserted and distinct strings in the concurrent table benchmark, max threads
+#define BENCH_CH_N 1000000
+#define BENCH_CH_W 100000
+#define BENCH_CH_THR 8
+
+// tables shared by the threads of the concurrent table benchmark
+struct bench__ch {
+    struct bench__strs *b;
+    // counted h_table behind a mutex, and ch_table
+    h_table *ht;
+    pthread_mutex_t mtx;
+    ch_table *ct;
+    int n_thr;
+};
+// argument of each thread: the shared tables, the thread's index, and the sum of its
+// search results
+struct bench__ch_arg {
+    struct bench__ch *c;
+    int id;
+    long sum;
+};
+
+// each thread inserts or searches for its share of the strings, with the h_table and
+// a mutex, or with the ch_table
+static void *bench__ch_ins_mutex_f(void *arg) {
+    struct bench__ch_arg *a = (struct bench__ch_arg *) arg;
+    size_t i;
+    for (i = a->id; i < a->c->b->n_ins; i += a->c->n_thr) {
+	pthread_mutex_lock(&a->c->mtx);
+	h_table_insert(a->c->ht, a->c->b->ins[i]);
+	pthread_mutex_unlock(&a->c->mtx);
+    }
+    return NULL;
+}
+static void *bench__ch_ins_f(void *arg) {
+    struct bench__ch_arg *a = (struct bench__ch_arg *) arg;
+    size_t i;
+    for (i = a->id; i < a->c->b->n_ins; i += a->c->n_thr) {
+	ch_table_insert(a->c->ct, a->c->b->ins[i]);
+    }
+    return NULL;
+}
+static void *bench__ch_sea_mutex_f(void *arg) {
+    struct bench__ch_arg *a = (struct bench__ch_arg *) arg;
+    size_t i;
+    for (i = a->id; i < a->c->b->n_qry; i += a->c->n_thr) {
+	pthread_mutex_lock(&a->c->mtx);
+	a->sum += h_table_nsearch(a->c->ht, a->c->b->qry[i]);
+	pthread_mutex_unlock(&a->c->mtx);
+    }
+    return NULL;
+}
+static void *bench__ch_sea_f(void *arg) {
+    struct bench__ch_arg *a = (struct bench__ch_arg *) arg;
+    size_t i;
+    for (i = a->id; i < a->c->b->n_qry; i += a->c->n_thr) {
+	a->sum += ch_table_nsearch(a->c->ct, a->c->b->qry[i]);
+    }
+    return NULL;
+}
+
+// runs f on c->n_thr threads, returning the elapsed time; *sum gets the sum of the
+// search results of the threads
+static double bench__ch_run(void *(*f)(void *), struct bench__ch *c, long *sum) {
+    pthread_t th[BENCH_CH_THR];
+    struct bench__ch_arg a[BENCH_CH_THR];
+    double t0 = bench__now();
+    int i;
+    for (i = 0; i < c->n_thr; i++) {
+	a[i].c = c;
+	a[i].id = i;
+	a[i].sum = 0;
+	pthread_create(th + i, NULL, f, a + i);
+    }
+    *sum = 0;
+    for (i = 0; i < c->n_thr; i++) {
+	pthread_join(th[i], NULL);
+	*sum += a[i].sum;
+    }
+    return bench__now() - t0;
+}
+
+// inserts BENCH_CH_N strings picked from BENCH_CH_W distinct strings from 1 to
+// BENCH_CH_THR threads, then searches for as many strings (half hits), with a counted
+// h_table behind a mutex and with a ch_table
+static void bench__ch_table(void) {
+    struct bench__strs b;
+    struct bench__ch c;
+    double t[4];
+    long sum[2];
+    srand(1);
+    bench__strs_new(&b, BENCH_CH_W, BENCH_CH_N, BENCH_CH_N, 0.5);
+    c.b = &b;
+    pthread_mutex_init(&c.mtx, NULL);
+    printf("insert %d strings (%d distinct), then search (half hits), Mops/s:\n"
+	   "           insert                              search\n"
+	   "  threads  mutex + h_table  ch_table  (speedup)  mutex + h_table  ch_table  "
+	   "(speedup)\n", BENCH_CH_N, BENCH_CH_W);
+    for (c.n_thr = 1; c.n_thr <= BENCH_CH_THR; c.n_thr *= 2) {
+	c.ht = new_h_table_hf(H_SIZ, h_fnv1a, H_COUNTED | H_ARENA);
+	c.ct = new_ch_table(CH_SHARDS);
+	t[0] = bench__ch_run(bench__ch_ins_mutex_f, &c, sum);
+	t[1] = bench__ch_run(bench__ch_ins_f, &c, sum);
+	t[2] = bench__ch_run(bench__ch_sea_mutex_f, &c, sum);
+	t[3] = bench__ch_run(bench__ch_sea_f, &c, sum + 1);
+	if (sum[0] != sum[1]) {
+	    fprintf(stderr, "%s: h_table and ch_table search results differ\n", PROGNAME);
+	    exit(1);
+	}
+	printf("  %7d  %15.2f  %8.2f  (%6.1fx)  %15.2f  %8.2f  (%6.1fx)\n", c.n_thr,
+	       b.n_ins / t[0] / 1e6, b.n_ins / t[1] / 1e6, t[0] / t[1],
+	       b.n_qry / t[2] / 1e6, b.n_qry / t[3] / 1e6, t[2] / t[3]);
+	free_h_table(c.ht);
+	free_ch_table(c.ct);
+    }
+    pthread_mutex_destroy(&c.mtx);
+    bench__strs_free(&b);
+}
+
+// no. distinct strings in the large table of the batched search benchmark
+#define BENCH_HB_N 4000000
+
+// searches for strings (half hits) one at a time with h_table_nsearch and in batches
+// with h_table_nsearch_batch, in a counted h_table that fits in the cache (strsea
+// input size) and in one of BENCH_HB_N strings that does not, and in a table with a
+// node per insert, where chains are longer
+static void bench__h_table_batch(void) {
+    struct bench__strs b;
+    double t[2];
+    long sum[2];
+    size_t i;
+    int k, *cnt;
+    srand(1);
+    printf("search (half hits), Mops/s:\n"
+	   "  table                                  nsearch  nsearch_batch  (speedup)\n");
+    for (k = 0; k < 3; k++) {
+	h_table *ht;
+	if (k == 0) {
+	    bench__strs_new(&b, 100, 1000, 1000000, 0.5);
+	    ht = new_h_table_hf(H_SIZ, h_fnv1a, H_COUNTED | H_ARENA);
+	}
+	else if (k == 1) {
+	    bench__strs_new(&b, BENCH_HB_N, BENCH_HB_N, BENCH_HB_N, 0.5);
+	    ht = new_h_table_hf(H_SIZ, h_fnv1a, H_COUNTED | H_ARENA);
+	}
+	else {
+	    bench__strs_new(&b, BENCH_HB_N / 16, BENCH_HB_N / 4, BENCH_HB_N / 4, 0.5);
+	    ht = new_h_table_hf(H_SIZ, h_fnv1a, H_ARENA);
+	}
+	for (i = 0; i < b.n_ins; i++) {
+	    h_table_insert(ht, b.ins[i]);
+	}
+	h_table_rehash(ht);
+	cnt = (int *) malloc(b.n_qry * sizeof(int));
+	sum[0] = sum[1] = 0;
+	t[0] = bench__now();
+	for (i = 0; i < b.n_qry; i++) {
+	    sum[0] += h_table_nsearch(ht, b.qry[i]);
+	}
+	t[0] = bench__now() - t[0];
+	t[1] = bench__now();
+	h_table_nsearch_batch(ht, b.qry, b.n_qry, cnt);
+	t[1] = bench__now() - t[1];
+	for (i = 0; i < b.n_qry; i++) {
+	    sum[1] += cnt[i];
+	}
+	if (sum[0] != sum[1]) {
+	    fprintf(stderr, "%s: h_table_nsearch_batch results differ\n", PROGNAME);
+	    exit(1);
+	}
+	printf("  %-8s %8lu of %8lu distinct  %7.2f  %13.2f  (%6.1fx)\n",
+	       (ht->counted) ? "counted" : "per node", (unsigned long) b.n_ins,
+	       (unsigned long) b.n_w, b.n_qry / t[0] / 1e6, b.n_qry / t[1] / 1e6,
+	       t[0] / t[1]);
+	free(cnt);
+	free_h_table(ht);
+	bench__strs_free(&b);
+    }
+}
+
+// no. distinct strings in the frozen table benchmark, and where the table is saved
+#define BENCH_FH_N 1000000
+#define BENCH_FH_BIN "/tmp/" PROGNAME "_fh.bin"
+
+// freezes a counted h_table of BENCH_FH_N strings, saves it and opens it again, then
+// searches for as many strings (half hits) in the h_table, the frozen table, and the
+// mapped file
+static void bench__fh_table(void) {
+    struct bench__strs b;
+    double t[6];
+    long sum[3];
+    size_t i;
+    int k;
+    srand(1);
+    bench__strs_new(&b, BENCH_FH_N, BENCH_FH_N, BENCH_FH_N, 0.5);
+    h_table *ht = new_h_table_hf(H_SIZ, h_fnv1a, H_COUNTED | H_ARENA);
+    for (i = 0; i < b.n_ins; i++) {
+	h_table_insert(ht, b.ins[i]);
+    }
+    t[0] = bench__now();
+    fh_table *ft = h_table_freeze(ht);
+    t[0] = bench__now() - t[0];
+    if (ft == NULL) {
+	perror(PROGNAME);
+	exit(1);
+    }
+    t[1] = bench__now();
+    if (fh_table_save(ft, BENCH_FH_BIN) != 0) {
+	perror(BENCH_FH_BIN);
+	exit(1);
+    }
+    t[1] = bench__now() - t[1];
+    t[2] = bench__now();
+    fh_table *fm = fh_table_open(BENCH_FH_BIN);
+    t[2] = bench__now() - t[2];
+    if (fm == NULL) {
+	perror(BENCH_FH_BIN);
+	exit(1);
+    }
+    for (k = 0; k < 3; k++) {
+	sum[k] = 0;
+	t[3 + k] = bench__now();
+	for (i = 0; i < b.n_qry; i++) {
+	    sum[k] += (k == 0) ? h_table_nsearch(ht, b.qry[i]) :
+		fh_table_nsearch((k == 1) ? ft : fm, b.qry[i]);
+	}
+	t[3 + k] = bench__now() - t[3 + k];
+    }
+    if (sum[0] != sum[1] || sum[0] != sum[2]) {
+	fprintf(stderr, "%s: h_table and fh_table search results differ\n", PROGNAME);
+	exit(1);
+    }
+    printf("%lu distinct strings, %.1f MB frozen (%.1f bytes per string):\n"
+	   "  freeze %.3f s, save %.3f s, open %.6f s\n"
+	   "  search (half hits), Mops/s: h_table %.2f, fh_table %.2f, mapped %.2f\n",
+	   (unsigned long) ft->n, ft->siz / 1e6, (double) ft->siz / ft->n, t[0], t[1],
+	   t[2], b.n_qry / t[3] / 1e6, b.n_qry / t[4] / 1e6, b.n_qry / t[5] / 1e6);
+    free_fh_table(fm);
+    free_fh_table(ft);
+    free_h_table(ht);
+    remove(BENCH_FH_BIN);
+    bench__strs_free(&b);
+}
+
+// no. distinct keys and no. inserts and searches in the d_hmap benchmark
+#define BENCH_HM_W 100000
+#define BENCH_HM_N 1000000
+
+// user hash and equality functions for the d_hmap benchmark, which time the generic
+// d_hmap path against the integer fast path the default callbacks take for long keys
+static uint64_t bench__hm_hash(const void *k, size_t n) {
+    const unsigned char *p = (const unsigned char *) k;
+    uint64_t h = 0xcbf29ce484222325ULL;
+    size_t i;
+    for (i = 0; i < n; i++) {
+	h = (h ^ p[i]) * 0x100000001b3ULL;
+    }
+    return h ^ (h >> 29);
+}
+static int bench__hm_eq(const void *a, const void *b, size_t n) {
+    return memcmp(a, b, n) == 0;
+}
+
+// counts the n longs of ins in hm, searches for the n longs of qry, then removes
+// every key again. writes the time taken by each step to t and returns the sum of the
+// counts found by the searches.
+static long bench__hm_longs(d_hmap *hm, long *ins, long *qry, size_t n, double *t) {
+    size_t i;
+    long one = 1, sum = 0, *c;
+    t[0] = bench__now();
+    for (i = 0; i < n; i++) {
+	c = (long *) d_hmap__get(hm, ins + i);
+	if (c != NULL) {
+	    (*c)++;
+	}
+	else {
+	    d_hmap__put(hm, ins + i, &one);
+	}
+    }
+    t[0] = bench__now() - t[0];
+    t[1] = bench__now();
+    for (i = 0; i < n; i++) {
+	c = (long *) d_hmap__get(hm, qry + i);
+	sum += (c != NULL) ? *c : 0;
+    }
+    t[1] = bench__now() - t[1];
+    t[2] = bench__now();
+    for (i = 0; i < n; i++) {
+	d_hmap__remove(hm, ins + i);
+    }
+    t[2] = bench__now() - t[2];
+    return sum;
+}
+
+// counts BENCH_HM_N strings picked from BENCH_HM_W distinct ones and then searches for
+// as many (half hits), with a counted h_table and with a d_hmap of char arrays to int.
+// then counts BENCH_HM_N random longs below BENCH_HM_W and searches for as many below
+// 2 * BENCH_HM_W, with a counted h_table of the longs printed as strings (what one
+// does without a map for integer keys), with a d_hmap of long to long, which takes
+// the integer fast path, and with the same d_hmap using user callbacks. the d_hmaps
+// also remove every key again.
+static void bench__d_hmap(void) {
+    struct bench__strs b;
+    char kb[BENCH_STR_LEN + 1];
+    double t[9];
+    long sum[4];
+    size_t i;
+    int one = 1, *c;
+    srand(1);
+    bench__strs_new(&b, BENCH_HM_W, BENCH_HM_N, BENCH_HM_N, 0.5);
+    h_table *ht = new_h_table_hf(H_SIZ, h_fnv1a, H_COUNTED | H_ARENA);
+    t[0] = bench__now();
+    for (i = 0; i < b.n_ins; i++) {
+	h_table_insert(ht, b.ins[i]);
+    }
+    t[0] = bench__now() - t[0];
+    sum[0] = 0;
+    t[1] = bench__now();
+    for (i = 0; i < b.n_qry; i++) {
+	sum[0] += h_table_nsearch(ht, b.qry[i]);
+    }
+    t[1] = bench__now() - t[1];
+    free_h_table(ht);
+    d_hmap *hm = d_hmap__new(DEFAULT_SIZ, sizeof(kb), sizeof(int), NULL, NULL);
+    kb[BENCH_STR_LEN] = '\0';
+    t[2] = bench__now();
+    for (i = 0; i < b.n_ins; i++) {
+	// strncpy pads the key with '\0', so equal strings are equal keys. strings are
+	// at most BENCH_STR_LEN chars, so kb[BENCH_STR_LEN] is always '\0'
+	strncpy(kb, b.ins[i], BENCH_STR_LEN);
+	c = (int *) d_hmap__get(hm, kb);
+	if (c != NULL) {
+	    (*c)++;
+	}
+	else {
+	    d_hmap__put(hm, kb, &one);
+	}
+    }
+    t[2] = bench__now() - t[2];
+    sum[1] = 0;
+    t[3] = bench__now();
+    for (i = 0; i < b.n_qry; i++) {
+	strncpy(kb, b.qry[i], BENCH_STR_LEN);
+	c = (int *) d_hmap__get(hm, kb);
+	sum[1] += (c != NULL) ? *c : 0;
+    }
+    t[3] = bench__now() - t[3];
+    d_hmap__free(hm);
+    bench__strs_free(&b);
+    if (sum[0] != sum[1]) {
+	fprintf(stderr, "%s: h_table and d_hmap string counts differ\n", PROGNAME);
+	exit(1);
+    }
+    printf("strings, Mops/s:\n"
+	   "  h_table (counted): insert %.2f, search %.2f\n"
+	   "  d_hmap (char[%d] to int): insert %.2f, search %.2f\n",
+	   BENCH_HM_N / t[0] / 1e6, BENCH_HM_N / t[1] / 1e6, BENCH_STR_LEN + 1,
+	   BENCH_HM_N / t[2] / 1e6, BENCH_HM_N / t[3] / 1e6);
+    // integer keys
+    long *ins = (long *) malloc(BENCH_HM_N * sizeof(long));
+    long *qry = (long *) malloc(BENCH_HM_N * sizeof(long));
+    for (i = 0; i < BENCH_HM_N; i++) {
+	ins[i] = rand() % BENCH_HM_W;
+	qry[i] = rand() % (2 * BENCH_HM_W);
+    }
+    ht = new_h_table_hf(H_SIZ, h_fnv1a, H_COUNTED | H_ARENA);
+    t[0] = bench__now();
+    for (i = 0; i < BENCH_HM_N; i++) {
+	snprintf(kb, sizeof(kb), "%ld", ins[i]);
+	h_table_insert(ht, kb);
+    }
+    t[0] = bench__now() - t[0];
+    sum[0] = 0;
+    t[1] = bench__now();
+    for (i = 0; i < BENCH_HM_N; i++) {
+	snprintf(kb, sizeof(kb), "%ld", qry[i]);
+	sum[0] += h_table_nsearch(ht, kb);
+    }
+    t[1] = bench__now() - t[1];
+    free_h_table(ht);
+    hm = d_hmap__new(DEFAULT_SIZ, sizeof(long), sizeof(long), NULL, NULL);
+    sum[2] = bench__hm_longs(hm, ins, qry, BENCH_HM_N, t + 3);
+    sum[1] = (long) hm->siz;
+    d_hmap__free(hm);
+    hm = d_hmap__new(DEFAULT_SIZ, sizeof(long), sizeof(long), bench__hm_hash,
+		     bench__hm_eq);
+    sum[3] = bench__hm_longs(hm, ins, qry, BENCH_HM_N, t + 6);
+    sum[1] += (long) hm->siz;
+    d_hmap__free(hm);
+    free(ins);
+    free(qry);
+    if (sum[0] != sum[2] || sum[0] != sum[3] || sum[1] != 0) {
+	fprintf(stderr, "%s: h_table and d_hmap long counts differ\n", PROGNAME);
+	exit(1);
+    }
+    printf("longs, Mops/s:\n"
+	   "  h_table (printed, counted): insert %.2f, search %.2f\n"
+	   "  d_hmap (long to long): insert %.2f, search %.2f, remove %.2f\n"
+	   "  d_hmap (user callbacks): insert %.2f, search %.2f, remove %.2f\n",
+	   BENCH_HM_N / t[0] / 1e6, BENCH_HM_N / t[1] / 1e6, BENCH_HM_N / t[3] / 1e6,
+	   BENCH_HM_N / t[4] / 1e6, BENCH_HM_N / t[5] / 1e6, BENCH_HM_N / t[6] / 1e6,
+	   BENCH_HM_N / t[7] / 1e6, BENCH_HM_N / t[8] / 1e6);
+}
+
+// no. distinct strings and inserts at the two scales of the rx_tree benchmark (the
+// first is that of sparse_array_input01.txt), and no. prefix searches
+#define BENCH_RX_W1 100
+#define BENCH_RX_N1 1000
+#define BENCH_RX_W2 100000
+#define BENCH_RX_N2 1000000
+#define BENCH_RX_P 1000
+
+// returns the no. strings inserted into ht that start with p, by looking at every node
+static int bench__h_table_npsearch(h_table *ht, char *p) {
+    size_t n = strlen(p);
+    ht_node *hp;
+    int i, c = 0;
+    for (i = 0; i < ht->siz; i++) {
+	for (hp = ht->table[i]; hp != NULL; hp = hp->next) {
+	    if (HT_STR_LEN(hp->str) >= n && memcmp(hp->str, p, n) == 0) {
+		c += hp->cnt;
+	    }
+	}
+    }
+    return c;
+}
+
+// inserts the same strings into a counted h_table and an rx_tree, at the scale of
+// sparse_array_input01.txt and at a larger one, and prints the memory each uses. at
+// the larger scale, also times the inserts, as many exact searches (half hits), and
+// BENCH_RX_P prefix searches for the first 1 to 3 chars of inserted strings, which the
+// h_table answers by looking at every string
+static void bench__rx_tree(void) {
+    struct bench__strs b;
+    char pb[4];
+    double t[6];
+    long sum[4];
+    size_t i, w[2] = {BENCH_RX_W1, BENCH_RX_W2}, n[2] = {BENCH_RX_N1, BENCH_RX_N2};
+    int k;
+    srand(1);
+    for (k = 0; k < 2; k++) {
+	bench__strs_new(&b, w[k], n[k], n[k], 0.5);
+	h_table *ht = new_h_table_hf(H_SIZ, h_fnv1a, H_COUNTED | H_ARENA);
+	rx_tree *rt = new_rx_tree();
+	t[0] = bench__now();
+	for (i = 0; i < b.n_ins; i++) {
+	    h_table_insert(ht, b.ins[i]);
+	}
+	t[0] = bench__now() - t[0];
+	t[1] = bench__now();
+	for (i = 0; i < b.n_ins; i++) {
+	    rx_tree_insert(rt, b.ins[i]);
+	}
+	t[1] = bench__now() - t[1];
+	h_table_rehash(ht);
+	printf("%lu inserts of %lu distinct strings, memory: h_table %lu bytes, rx_tree "
+	       "%lu bytes (%lu nodes)\n", (unsigned long) n[k], (unsigned long) w[k],
+	       (unsigned long) h_table_mem(ht), (unsigned long) rt->mem,
+	       (unsigned long) rt->n);
+	if (k == 1) {
+	    sum[0] = sum[1] = 0;
+	    t[2] = bench__now();
+	    for (i = 0; i < b.n_qry; i++) {
+		sum[0] += h_table_nsearch(ht, b.qry[i]);
+	    }
+	    t[2] = bench__now() - t[2];
+	    t[3] = bench__now();
+	    for (i = 0; i < b.n_qry; i++) {
+		sum[1] += rx_tree_nsearch(rt, b.qry[i]);
+	    }
+	    t[3] = bench__now() - t[3];
+	    sum[2] = sum[3] = 0;
+	    t[4] = t[5] = 0;
+	    for (i = 0; i < BENCH_RX_P; i++) {
+		memset(pb, 0, sizeof(pb));
+		strncpy(pb, b.ins[i], 1 + i % 3);
+		t[4] -= bench__now();
+		sum[2] += bench__h_table_npsearch(ht, pb);
+		t[4] += bench__now();
+		t[5] -= bench__now();
+		sum[3] += rx_tree_npsearch(rt, pb);
+		t[5] += bench__now();
+	    }
+	    if (sum[0] != sum[1] || sum[2] != sum[3]) {
+		fprintf(stderr, "%s: h_table and rx_tree counts differ\n", PROGNAME);
+		exit(1);
+	    }
+	    printf("insert, Mops/s: h_table %.2f, rx_tree %.2f\n"
+		   "search (half hits), Mops/s: h_table %.2f, rx_tree %.2f\n"
+		   "prefix search, us per search: h_table (scan) %.1f, rx_tree %.3f\n",
+		   n[k] / t[0] / 1e6, n[k] / t[1] / 1e6, b.n_qry / t[2] / 1e6,
+		   b.n_qry / t[3] / 1e6, t[4] / BENCH_RX_P * 1e6, t[5] / BENCH_RX_P * 1e6);
+	}
+	free_rx_tree(rt);
+	free_h_table(ht);
+	bench__strs_free(&b);
+    }
+}
+
+// no. distinct strings, inserts, and searches for strings that were never inserted
+// in the cm_table benchmark, and the widths of its sketches
+#define BENCH_CM_W 100000
+#define BENCH_CM_N 1000000
+#define BENCH_CM_Q 100000
+#define BENCH_CM_W1 16384
+#define BENCH_CM_W2 65536
+
+// counts BENCH_CM_N inserts of BENCH_CM_W distinct strings with a counted h_table and
+// with cm_tables of depth CM_D and two widths. for each cm_table, prints the insert
+// speed, memory, how much the distinct strings are overcounted compared to the
+// h_table and how many are within the (e / w) N bound, the mean count of
+// BENCH_CM_Q strings that were never inserted, the same overcount for two sketches of
+// half the inserts each merged together, and the error of the distinct count
+static void bench__cm_table(void) {
+    struct bench__strs b;
+    double t, over[2], bound, est;
+    size_t i, j, n_in, max, w[2] = {BENCH_CM_W1, BENCH_CM_W2};
+    long neg;
+    ht_node *hp;
+    int k, c;
+    srand(1);
+    bench__strs_new(&b, BENCH_CM_W, BENCH_CM_N, BENCH_CM_Q, 0);
+    h_table *ht = new_h_table_hf(H_SIZ, h_fnv1a, H_COUNTED | H_ARENA);
+    t = bench__now();
+    for (i = 0; i < b.n_ins; i++) {
+	h_table_insert(ht, b.ins[i]);
+    }
+    t = bench__now() - t;
+    h_table_rehash(ht);
+    printf("%lu inserts of %lu distinct strings, h_table: %.2f Mops/s, %.1f MB\n",
+	   (unsigned long) b.n_ins, (unsigned long) ht->n, b.n_ins / t / 1e6,
+	   h_table_mem(ht) / 1e6);
+    for (k = 0; k < 2; k++) {
+	cm_table *cm = new_cm_table(w[k], CM_D);
+	cm_table *ch[2] = {new_cm_table(w[k], CM_D), new_cm_table(w[k], CM_D)};
+	t = bench__now();
+	for (i = 0; i < b.n_ins; i++) {
+	    cm_table_insert(cm, b.ins[i]);
+	}
+	t = bench__now() - t;
+	for (i = 0; i < b.n_ins; i++) {
+	    cm_table_insert(ch[i >= b.n_ins / 2], b.ins[i]);
+	}
+	cm_table_merge(ch[0], ch[1]);
+	bound = M_E / cm->w * b.n_ins;
+	over[0] = over[1] = 0;
+	n_in = max = 0;
+	for (j = 0; j < (size_t) ht->siz; j++) {
+	    for (hp = ht->table[j]; hp != NULL; hp = hp->next) {
+		c = cm_table_nsearch(cm, hp->str) - hp->cnt;
+		over[0] += c;
+		over[1] += cm_table_nsearch(ch[0], hp->str) - hp->cnt;
+		n_in += (c <= bound);
+		if ((size_t) c > max) {
+		    max = (size_t) c;
+		}
+	    }
+	}
+	neg = 0;
+	for (i = 0; i < b.n_qry; i++) {
+	    neg += cm_table_nsearch(cm, b.qry[i]) - h_table_nsearch(ht, b.qry[i]);
+	}
+	est = cm_table_ndistinct(cm);
+	printf("cm_table, w %lu, d %d: %.2f Mops/s, %.1f MB\n"
+	       "  overcount: mean %.3f, max %lu, within bound %.0f: %.2f%%; never inserted: "
+	       "mean %.3f\n"
+	       "  merged halves: mean overcount %.3f; distinct: %.0f (error %.2f%%)\n",
+	       (unsigned long) cm->w, CM_D, b.n_ins / t / 1e6,
+	       (cm->w * cm->d * sizeof(uint32_t) + ((size_t) 1 << cm->p)) / 1e6,
+	       over[0] / ht->n, (unsigned long) max, bound, 100.0 * n_in / ht->n,
+	       (double) neg / b.n_qry, over[1] / ht->n, est,
+	       100.0 * (est - (double) ht->n) / ht->n);
+	free_cm_table(cm);
+	free_cm_table(ch[0]);
+	free_cm_table(ch[1]);
+    }
+    free_h_table(ht);
+    bench__strs_free(&b);
+}
+
+// no. distinct strings and searches in the Bloom filter benchmark, and its no. hit
+// ratios
+#define BENCH_BL_N 1000000
+#define BENCH_BL_HITS 5
+
+// inserts BENCH_BL_N strings (some of them the same) into counted h_tables with no
+// Bloom filter and with filters for false positive rates of H_BLOOM_FP and
+// H_BLOOM_FP / 10, then searches for BENCH_BL_N strings, at hit ratios from 0 (none
+// of the strings was inserted) to 1.
+// for each filter, the false positive rate is measured on the strings that were never
+// inserted
+static void bench__h_table_bloom(void) {
+    struct bench__strs b;
+    double hit[BENCH_BL_HITS] = {0, 0.1, 0.5, 0.9, 1}, fp[3] = {0, H_BLOOM_FP,
+								 H_BLOOM_FP / 10};
+    double t[3], t_i[3];
+    long sum[3], f_p[3], neg;
+    h_table *ht[3];
+    size_t i;
+    int j, k;
+    srand(1);
+    bench__strs_new(&b, BENCH_BL_N, BENCH_BL_N, 0, 0);
+    for (k = 0; k < 3; k++) {
+	ht[k] = new_h_table_hf(H_SIZ, h_fnv1a, H_COUNTED | H_ARENA);
+	// size the filters for the no. distinct strings, which the table without a
+	// filter has counted
+	if (fp[k] > 0) {
+	    h_table_set_bloom(ht[k], ht[0]->n, fp[k]);
+	}
+	t_i[k] = bench__now();
+	for (i = 0; i < b.n_ins; i++) {
+	    h_table_insert(ht[k], b.ins[i]);
+	}
+	t_i[k] = bench__now() - t_i[k];
+	h_table_rehash(ht[k]);
+    }
+    printf("%lu distinct strings, memory: no filter %.1f MB, fp %g %.1f MB, "
+	   "fp %g %.1f MB\n"
+	   "insert, Mops/s: no filter %.2f, fp %g %.2f, fp %g %.2f\n"
+	   "search, Mops/s (measured false positive rate):\n",
+	   (unsigned long) ht[0]->n, h_table_mem(ht[0]) / 1e6, fp[1],
+	   h_table_mem(ht[1]) / 1e6, fp[2], h_table_mem(ht[2]) / 1e6,
+	   b.n_ins / t_i[0] / 1e6, fp[1], b.n_ins / t_i[1] / 1e6, fp[2],
+	   b.n_ins / t_i[2] / 1e6);
+    // queries are the inserted strings, or new strings that were never inserted
+    char **qry = (char **) malloc(BENCH_BL_N * sizeof(char *));
+    char *is_new = (char *) malloc(BENCH_BL_N);
+    for (j = 0; j < BENCH_BL_HITS; j++) {
+	for (i = 0; i < BENCH_BL_N; i++) {
+	    is_new[i] = ((double) rand() / RAND_MAX >= hit[j]);
+	    qry[i] = (is_new[i]) ? bench__word() : b.ins[(size_t) rand() % b.n_ins];
+	}
+	for (k = 0; k < 3; k++) {
+	    sum[k] = 0;
+	    t[k] = bench__now();
+	    for (i = 0; i < BENCH_BL_N; i++) {
+		sum[k] += h_table_nsearch(ht[k], qry[i]);
+	    }
+	    t[k] = bench__now() - t[k];
+	}
+	if (sum[0] != sum[1] || sum[0] != sum[2]) {
+	    fprintf(stderr, "%s: h_table searches with and without Bloom filter differ\n",
+		    PROGNAME);
+	    exit(1);
+	}
+	neg = f_p[1] = f_p[2] = 0;
+	for (i = 0; i < BENCH_BL_N; i++) {
+	    if (h_table_nsearch(ht[0], qry[i]) == 0) {
+		neg++;
+		f_p[1] += h_table_maybe(ht[1], qry[i]);
+		f_p[2] += h_table_maybe(ht[2], qry[i]);
+	    }
+	    if (is_new[i]) {
+		free(qry[i]);
+	    }
+	}
+	printf("  hit ratio %.1f: no filter %.2f, fp %g %.2f (%.4f), fp %g %.2f (%.4f)\n",
+	       hit[j], BENCH_BL_N / t[0] / 1e6, fp[1], BENCH_BL_N / t[1] / 1e6,
+	       (neg > 0) ? (double) f_p[1] / neg : 0.0, fp[2], BENCH_BL_N / t[2] / 1e6,
+	       (neg > 0) ? (double) f_p[2] / neg : 0.0);
+    }
+    free(qry);
+    free(is_new);
+    bench__strs_free(&b);
+    for (k = 0; k < 3; k++) {
+	free_h_table(ht[k]);
+    }
+}
+
+// no. distinct strings and inserts in the ss_table benchmark, the exponent of the Zipf
+// distribution the inserts are drawn from, the no. most frequent strings wanted, and
+// the no. counters of its ss_tables
+#define BENCH_SS_W 500000
+#define BENCH_SS_N 2000000
+#define BENCH_SS_Z 1.1
+#define BENCH_SS_K 100
+#define BENCH_SS_M1 1024
+#define BENCH_SS_M2 8192
+
+// qsort comparator for pointers to ht_nodes, larger counts first
+static int bench__cmp_cnt(const void *a, const void *b) {
+    int x = (*(ht_node **) a)->cnt, y = (*(ht_node **) b)->cnt;
+    return (x < y) - (x > y);
+}
+
+// finds the BENCH_SS_K most frequent of BENCH_SS_N strings drawn from BENCH_SS_W
+// distinct strings with Zipf exponent BENCH_SS_Z, with a counted h_table followed by
+// a sort of its nodes, and with ss_tables of two sizes. for each ss_table, prints the
+// speed, the memory, how many of the strings it reports are in the true top
+// BENCH_SS_K, how many it marks as certain to be, and the largest overcount. exits if
+// a true count is outside the range an ss_table gives for it
+static void bench__ss_table(void) {
+    struct bench__strs b;
+    double t, u, *cdf;
+    size_t i, j, lo, hi, n_nd, n_top, m[2] = {BENCH_SS_M1, BENCH_SS_M2};
+    ht_node **nd, *hp;
+    ss_node *top[BENCH_SS_K + 1];
+    int k, c, n_in, n_cert, max, next;
+    srand(1);
+    bench__strs_new(&b, BENCH_SS_W, BENCH_SS_N, 0, 0);
+    // redraw the inserts so that the i-th distinct string is picked with probability
+    // proportional to 1 / (i + 1)^BENCH_SS_Z
+    cdf = (double *) malloc(b.n_w * sizeof(double));
+    for (u = 0, i = 0; i < b.n_w; i++) {
+	u += pow((double) (i + 1), -BENCH_SS_Z);
+	cdf[i] = u;
+    }
+    for (i = 0; i < b.n_ins; i++) {
+	u = rand() / (RAND_MAX + 1.0) * cdf[b.n_w - 1];
+	for (lo = 0, hi = b.n_w - 1; lo < hi; ) {
+	    j = (lo + hi) / 2;
+	    if (cdf[j] < u) {
+		lo = j + 1;
+	    }
+	    else {
+		hi = j;
+	    }
+	}
+	b.ins[i] = b.w[lo];
+    }
+    free(cdf);
+    // exact counts, then every node sorted by count
+    h_table *ht = new_h_table_hf(H_SIZ, h_fnv1a, H_COUNTED | H_ARENA);
+    t = bench__now();
+    for (i = 0; i < b.n_ins; i++) {
+	h_table_insert(ht, b.ins[i]);
+    }
+    h_table_rehash(ht);
+    nd = (ht_node **) malloc(ht->n * sizeof(ht_node *));
+    for (n_nd = 0, i = 0; i < (size_t) ht->siz; i++) {
+	for (hp = ht->table[i]; hp != NULL; hp = hp->next) {
+	    nd[n_nd++] = hp;
+	}
+    }
+    qsort(nd, n_nd, sizeof(ht_node *), bench__cmp_cnt);
+    t = bench__now() - t;
+    printf("%lu inserts of %lu distinct strings (Zipf %.1f), top %d\n"
+	   "h_table and sort: %.2f Mops/s, %.1f MB\n", (unsigned long) b.n_ins,
+	   (unsigned long) n_nd, BENCH_SS_Z, BENCH_SS_K, b.n_ins / t / 1e6,
+	   (h_table_mem(ht) + n_nd * sizeof(ht_node *)) / 1e6);
+    for (k = 0; k < 2; k++) {
+	ss_table *ss = new_ss_table(m[k]);
+	t = bench__now();
+	for (i = 0; i < b.n_ins; i++) {
+	    ss_table_insert(ss, b.ins[i]);
+	}
+	n_top = ss_table_top(ss, top, BENCH_SS_K + 1);
+	t = bench__now() - t;
+	// count of the string after the top BENCH_SS_K, or the smallest count if there
+	// is none
+	next = (n_top > BENCH_SS_K) ? top[BENCH_SS_K]->cnt : ss_table_min(ss);
+	n_in = n_cert = max = 0;
+	for (i = 0; i < BENCH_SS_K && i < n_top; i++) {
+	    c = h_table_nsearch(ht, top[i]->str);
+	    if (c < top[i]->cnt - top[i]->err || c > top[i]->cnt) {
+		fprintf(stderr, "%s: ss_table count of %s is %d to %d, but it is %d\n",
+			PROGNAME, top[i]->str, top[i]->cnt - top[i]->err, top[i]->cnt, c);
+		exit(1);
+	    }
+	    // ties with the last of the true top count as in it
+	    n_in += (c >= nd[BENCH_SS_K - 1]->cnt);
+	    n_cert += (top[i]->cnt - top[i]->err >= next);
+	    if (top[i]->cnt - c > max) {
+		max = top[i]->cnt - c;
+	    }
+	}
+	printf("ss_table, m %lu: %.2f Mops/s, %.3f MB; %d in true top, %d certain, "
+	       "max overcount %d\n", (unsigned long) m[k], b.n_ins / t / 1e6,
+	       ss_table_mem(ss) / 1e6, n_in, n_cert, max);
+	free_ss_table(ss);
+    }
+    free(nd);
+    free_h_table(ht);
+    bench__strs_free(&b);
+}
+
+// benchmark name and function
+struct bench {
+    const char *name;
+    void (*f)(void);
+};
+// table of all benchmarks, terminated by a NULL entry
+static const struct bench benches[] = {
+    {"d_array__range", bench__d_array__range},
+    {"d_array_t", bench__d_array_t},
+    {"d_array__get_u", bench__d_array__get_u},
+    {"d_arena", bench__d_arena},
+    {"d_array__policy", bench__d_array__policy},
+    {"g_array", bench__g_array},
+    {"d_array__remove_if", bench__d_array__remove_if},
+    {"d_array__write", bench__d_array__write},
+    {"d_fmt", bench__d_fmt},
+    {"d_array__sort", bench__d_array__sort},
+    {"d_mmap", bench__d_mmap},
+    {"c_array", bench__c_array},
+    {"sh_table", bench__sh_table},
+    {"h_table_grow", bench__h_table_grow},
+    {"h_table_counted", bench__h_table_counted},
+    {"h_table_arena", bench__h_table_arena},
+    {"ch_table", bench__ch_table},
+    {"h_table_batch", bench__h_table_batch},
+    {"fh_table", bench__fh_table},
+    {"d_hmap", bench__d_hmap},
+    {"rx_tree", bench__rx_tree},
+    {"cm_table", bench__cm_table},
+    {"h_table_bloom", bench__h_table_bloom},
+    {"ss_table", bench__ss_table},
+    {NULL, NULL}
+};
+
+// runs the benchmark called name, or all benchmarks if name is NULL. returns 0 on
+// success, 1 if no benchmark is called name
+static int bench__run(const char *name) {
+    const struct bench *b;
+    int found = 0;
+    for (b = benches; b->name != NULL; b++) {
+	if (name == NULL || strcmp(name, b->name) == 0) {
+	    printf("[%s]\n", b->name);
+	    b->f();
+	    found = 1;
+	}
+    }
+    if (!found) {
+	fprintf(stderr, "%s: unknown benchmark \'%s\'\n", PROGNAME, name);
+	return 1;
+    }
+    return 0;
+}
+
 // driver program to test any features in the custom_lib
 int main(int argc, char **argv) {
     // run normally if there are no arguments
@@ -57,7 +2064,7 @@ int main(int argc, char **argv) {
 	int n;
 	n = 10;
 	// memory taken is 4 * n bytes, with 0 elements (da->siz is  0)
-	d_array *da = d_array__new(n, sizeof(int));
+	d_array *da = d_array__new(n, D_ARRAY__INT);
 	int i;
 	// append n items
 	for (i = 0; i < n; i++) {
@@ -92,14 +2099,339 @@ int main(int argc, char **argv) {
 	for (i = 0; i < n; i = i + 2) {
 	    d_array__set(da, i, &j);
 	}
-	// print results using d_array__get()
-	for (i = 0; i < n; i++) {
-	    printf("%d", *((int *) d_array__get(da, i)));
-	    if (i < da->siz - 1) { printf(" "); }
+	// print results by iterating over the elements
+	D_ARRAY__FOREACH(int, p, da) {
+	    printf("%d", *p);
+	    if (p + 1 != (int *) d_array__end(da)) { printf(" "); }
 	}
 	printf("\n");
+	// insert n items at index n / 2 with one call, then remove them with one call
+	int *r = (int *) malloc(n * sizeof(int));
+	for (i = 0; i < n; i++) {
+	    r[i] = -i;
+	}
+	d_array__insert_range(da, r, n, n / 2);
+	char *s = d_array__tostr(ALL__(da));
+	printf("%s\n", s);
+	free(s);
+	d_array__remove_range(da, n / 2, n / 2 + n);
+	s = d_array__tostr(ALL__(da));
+	printf("%s\n", s);
+	free(s);
+	free(r);
 	// free memory
 	d_array__free(da);
+	// make a few d_arrays from a d_arena, then release them all with one reset
+	d_arena *ar = d_arena__new(D_ARENA__BLK_SIZ);
+	d_array *das[3];
+	for (j = 0; j < 3; j++) {
+	    das[j] = d_array__new_with_alloc(AUTO_SIZ, D_ARRAY__INT, d_arena__al(ar));
+	    for (i = 0; i < n * (j + 1); i++) {
+		d_array__append(das[j], &i);
+	    }
+	}
+	for (j = 0; j < 3; j++) {
+	    s = d_array__tostr(ALL__(das[j]));
+	    printf("%s\n", s);
+	    free(s);
+	}
+	d_arena__reset(ar);
+	d_arena__free(ar);
+	// capacity management: reserve, shrink, and count resizes
+	da = d_array__new(AUTO_SIZ, D_ARRAY__INT);
+	d_array__reserve(da, n * n);
+	printf("reserved: siz %lu, max_siz %lu\n", (unsigned long) da->siz,
+	       (unsigned long) da->max_siz);
+	for (i = 0; i < n; i++) {
+	    d_array__append(da, &i);
+	}
+	d_array__shrink_to_fit(da);
+	printf("shrunk to fit: siz %lu, max_siz %lu, n_realloc %lu\n",
+	       (unsigned long) da->siz, (unsigned long) da->max_siz,
+	       (unsigned long) da->n_realloc);
+	d_array__set_policy(da, D_ARRAY__POLICY__NO_SHRINK);
+	d_array__remove_range(ALL__(da));
+	printf("no shrink after clear: siz %lu, max_siz %lu, n_realloc %lu\n",
+	       (unsigned long) da->siz, (unsigned long) da->max_siz,
+	       (unsigned long) da->n_realloc);
+	d_array__free(da);
+	// g_array: prepend n items, then edit around a cursor in the middle
+	g_array *ga = g_array__new(AUTO_SIZ, D_ARRAY__INT);
+	for (i = 0; i < n; i++) {
+	    g_array__insert(ga, &i, 0);
+	}
+	j = 444;
+	for (i = 0; i < 3; i++) {
+	    g_array__insert(ga, &j, n / 2 + i);
+	}
+	g_array__remove(ga, n / 2 - 1);
+	s = g_array__tostr(ALL__(ga));
+	printf("%s\n", s);
+	free(s);
+	g_array__free(ga);
+	// remove the multiples of 3 in one pass, then the elements at a few indices
+	da = bench__iota(3 * n);
+	j = 3;
+	d_array__remove_if(da, bench__is_mult, &j);
+	size_t idx[4] = {9, 0, 3, 9};
+	d_array__remove_many(da, idx, 4);
+	s = d_array__tostr(ALL__(da));
+	printf("%s\n", s);
+	free(s);
+	// write straight to stdout without building a string, then into a buffer that
+	// is too small, which cuts the output off like snprintf
+	d_writer w = d_writer__file(stdout);
+	d_array__write(ALL__(da), &w);
+	printf("\n");
+	char wb_s[16];
+	d_wbuf wb;
+	w = d_writer__buf(&wb, wb_s, sizeof(wb_s));
+	d_array__write(ALL__(da), &w);
+	printf("%s (%lu of %lu chars)\n", wb_s, (unsigned long) strlen(wb_s),
+	       (unsigned long) wb.len);
+	d_array__free(da);
+	// long and double d_arrays print too; doubles with the fewest digits that read
+	// back as the same double
+	long lv[3] = {-9223372036854775807L - 1, 0, 42};
+	double dv[6] = {0.1, 0.1 + 0.2, -2.5, 1e-7, 1e300, 1.0 / 3};
+	da = d_array__new(DEFAULT_SIZ, D_ARRAY__LONG);
+	d_array__append_n(da, lv, 3);
+	s = d_array__tostr(ALL__(da));
+	printf("%s\n", s);
+	free(s);
+	d_array__free(da);
+	da = d_array__new(DEFAULT_SIZ, D_ARRAY__DOUBLE);
+	d_array__append_n(da, dv, 6);
+	s = d_array__tostr(ALL__(da));
+	printf("%s\n", s);
+	free(s);
+	// sort without a comparator (radix sort), then search the sorted d_array
+	d_array__sort(da, NULL);
+	s = d_array__tostr(ALL__(da));
+	printf("sorted: %s, ", s);
+	free(s);
+	double d_k = 0.5;
+	printf("lower bound of %g: %lu, ", d_k,
+	       (unsigned long) d_array__lower_bound(da, &d_k, NULL));
+	printf("-2.5 %s\n", (d_array__bsearch(da, dv + 2, NULL) != NULL) ? "found" :
+	       "not found");
+	// save the sorted d_array, then map it back copy-on-write and change it; the file
+	// keeps the saved elements
+	if (d_array__save(da, BENCH_MMAP_BIN) != 0) {
+	    perror(PROGNAME);
+	}
+	d_array__free(da);
+	da = d_array__open_mmap(BENCH_MMAP_BIN, D_ARRAY__MMAP_COW);
+	if (da == NULL) {
+	    perror(PROGNAME);
+	}
+	else {
+	    d_k = 42;
+	    d_array__set(da, 0, &d_k);
+	    d_array__append(da, &d_k);
+	    s = d_array__tostr(ALL__(da));
+	    printf("mapped and changed: %s\n", s);
+	    free(s);
+	    d_array__free(da);
+	    da = d_array__open_mmap(BENCH_MMAP_BIN, D_ARRAY__MMAP_RDONLY);
+	    s = d_array__tostr(ALL__(da));
+	    printf("mapped again: %s\n", s);
+	    free(s);
+	    d_array__free(da);
+	}
+	remove(BENCH_MMAP_BIN);
+	// append from two threads at once without a lock, then seal into a d_array
+	struct bench__ca b;
+	pthread_t th[2];
+	b.n = 5;
+	b.ca = c_array__new(AUTO_SIZ, D_ARRAY__INT);
+	for (i = 0; i < 2; i++) {
+	    pthread_create(th + i, NULL, bench__ca_atomic_f, &b);
+	}
+	for (i = 0; i < 2; i++) {
+	    pthread_join(th[i], NULL);
+	}
+	da = c_array__seal(b.ca);
+	d_array__sort(da, NULL);
+	s = d_array__tostr(ALL__(da));
+	printf("c_array from 2 threads, sealed and sorted: %s\n", s);
+	free(s);
+	d_array__free(da);
+	// count strings with the open addressing table; the table grows past its first
+	// group of 16 slots
+	char *sw[4] = {"abc", "cba", "bca", "abc"};
+	char sw_b[8];
+	sh_table *st = new_sh_table(0);
+	for (i = 0; i < 40; i++) {
+	    sh_table_insert(st, sw[i % 4]);
+	    snprintf(sw_b, sizeof(sw_b), "w%d", i % 20);
+	    sh_table_insert(st, sw_b);
+	}
+	printf("sh_table: %lu distinct in %lu slots, abc %d, cba %d, w7 %d, xyz %d\n",
+	       (unsigned long) st->siz, (unsigned long) st->cap, sh_table_nsearch(st, "abc"),
+	       sh_table_nsearch(st, "cba"), sh_table_nsearch(st, "w7"),
+	       sh_table_nsearch(st, "xyz"));
+	free_sh_table(st);
+	// an h_table that starts with 2 buckets and doubles while strings are inserted
+	h_table *ht = new_h_table(2);
+	for (i = 0; i < 40; i++) {
+	    h_table_insert(ht, sw[i % 4]);
+	}
+	printf("h_table: %lu nodes in %d buckets (rehashing: %s), abc %d, cba %d, ",
+	       (unsigned long) ht->n, ht->siz, (ht->o_table != NULL) ? "yes" : "no",
+	       h_table_nsearch(ht, "abc"), h_table_nsearch(ht, "cba"));
+	h_table_rehash(ht);
+	printf("after rehash: abc %d\n", h_table_nsearch(ht, "abc"));
+	free_h_table(ht);
+	// same strings in a counted h_table, which only needs a node per distinct string,
+	// with nodes and strings from arenas
+	ht = new_h_table_hf(2, h_fnv1a, H_COUNTED | H_ARENA);
+	for (i = 0; i < 40; i++) {
+	    h_table_insert(ht, sw[i % 4]);
+	}
+	printf("counted h_table: %lu nodes, abc %d, cba %d, xyz %d\n", (unsigned long) ht->n,
+	       h_table_nsearch(ht, "abc"), h_table_nsearch(ht, "cba"),
+	       h_table_nsearch(ht, "xyz"));
+	// the same searches in one batch
+	char *sq[3] = {"abc", "cba", "xyz"};
+	int sc[3];
+	h_table_nsearch_batch(ht, sq, 3, sc);
+	printf("batch: abc %d, cba %d, xyz %d\n", sc[0], sc[1], sc[2]);
+	// freeze the table, save it, and search the mapped file
+	fh_table *ft = h_table_freeze(ht);
+	free_h_table(ht);
+	if (ft == NULL || fh_table_save(ft, BENCH_FH_BIN) != 0) {
+	    perror(PROGNAME);
+	}
+	else {
+	    free_fh_table(ft);
+	    ft = fh_table_open(BENCH_FH_BIN);
+	    if (ft == NULL) {
+		perror(BENCH_FH_BIN);
+	    }
+	    else {
+		printf("frozen and mapped: %lu strings, abc %d, cba %d, bca %d, xyz %d\n",
+		       (unsigned long) ft->n, fh_table_nsearch(ft, "abc"),
+		       fh_table_nsearch(ft, "cba"), fh_table_nsearch(ft, "bca"),
+		       fh_table_nsearch(ft, "xyz"));
+		free_fh_table(ft);
+	    }
+	}
+	remove(BENCH_FH_BIN);
+	// insert from two threads while this thread searches, with no lock
+	struct bench__strs bs;
+	struct bench__ch bc;
+	struct bench__ch_arg ba[2];
+	long sea, n_sea;
+	int mid, first;
+	srand(2);
+	bench__strs_new(&bs, 1000, 20000, 0, 0);
+	// no. times the first string is inserted, which the searches should all reach
+	sea = 0;
+	for (i = 0; i < (int) bs.n_ins; i++) {
+	    sea += (strcmp(bs.ins[i], bs.ins[0]) == 0);
+	}
+	bc.b = &bs;
+	bc.ct = new_ch_table(4);
+	bc.n_thr = 2;
+	for (i = 0; i < 2; i++) {
+	    ba[i].c = &bc;
+	    ba[i].id = i;
+	    pthread_create(th + i, NULL, bench__ch_ins_f, ba + i);
+	}
+	// search while the inserts run, until every insert of the string is seen
+	first = ch_table_nsearch(bc.ct, bs.ins[0]);
+	n_sea = 1;
+	for (mid = first; mid < sea; n_sea++) {
+	    sched_yield();
+	    mid = ch_table_nsearch(bc.ct, bs.ins[0]);
+	}
+	for (i = 0; i < 2; i++) {
+	    pthread_join(th[i], NULL);
+	}
+	printf("ch_table from 2 threads: %s counted %d times by the first search during "
+	       "the inserts, %d by search %ld (inserted %ld times)\n", bs.ins[0], first,
+	       mid, n_sea, sea);
+	free_ch_table(bc.ct);
+	bench__strs_free(&bs);
+	// map ints to doubles, overwrite one value, remove the even keys, and iterate
+	// over the rest
+	d_hmap *hm = d_hmap__new(0, sizeof(int), sizeof(double), NULL, NULL);
+	double hv;
+	void *hk, *hp;
+	size_t hi;
+	for (i = 0; i < 20; i++) {
+	    hv = i * 0.5;
+	    d_hmap__put(hm, &i, &hv);
+	}
+	hv = 100;
+	i = 3;
+	d_hmap__put(hm, &i, &hv);
+	for (i = 0; i < 20; i += 2) {
+	    d_hmap__remove(hm, &i);
+	}
+	i = 4;
+	printf("d_hmap: %lu entries in %lu slots, 3 -> %g, 4 %s; ",
+	       (unsigned long) hm->siz, (unsigned long) hm->cap,
+	       *(double *) d_hmap__get(hm, &(int) {3}),
+	       (d_hmap__get(hm, &i) == NULL) ? "removed" : "present");
+	hv = 0;
+	for (hi = 0; (hi = d_hmap__next(hm, hi, &hk, &hp)) != 0; ) {
+	    printf("%d ", *(int *) hk);
+	    hv += *(double *) hp;
+	}
+	printf("(value sum %g)\n", hv);
+	d_hmap__free(hm);
+	// exact and prefix counts with a radix tree
+	char *rw[6] = {"romane", "romanus", "romulus", "rubens", "ruber", "romane"};
+	rx_tree *rt = new_rx_tree();
+	for (i = 0; i < 6; i++) {
+	    rx_tree_insert(rt, rw[i]);
+	}
+	printf("rx_tree: %lu nodes, romane %d, roman %d; starting with r %d, rom %d, "
+	       "roma %d, rub %d, x %d\n", (unsigned long) rt->n,
+	       rx_tree_nsearch(rt, "romane"), rx_tree_nsearch(rt, "roman"),
+	       rx_tree_npsearch(rt, "r"), rx_tree_npsearch(rt, "rom"),
+	       rx_tree_npsearch(rt, "roma"),
+	       rx_tree_npsearch(rt, "rub"), rx_tree_npsearch(rt, "x"));
+	free_rx_tree(rt);
+	// approximate counts in two sketches, merged into one
+	cm_table *cm[2] = {new_cm_table(CM_W, CM_D), new_cm_table(CM_W, CM_D)};
+	for (i = 0; i < 6; i++) {
+	    cm_table_insert(cm[i % 2], rw[i]);
+	}
+	cm_table_merge(cm[0], cm[1]);
+	printf("cm_table merged: %lu inserts, romane %d, ruber %d, x %d, distinct about "
+	       "%.1f\n", (unsigned long) cm[0]->n, cm_table_nsearch(cm[0], "romane"),
+	       cm_table_nsearch(cm[0], "ruber"), cm_table_nsearch(cm[0], "x"),
+	       cm_table_ndistinct(cm[0]));
+	free_cm_table(cm[0]);
+	free_cm_table(cm[1]);
+	// a counted h_table with a Bloom filter in front of it
+	ht = new_h_table_hf(2, h_fnv1a, H_COUNTED | H_ARENA);
+	h_table_set_bloom(ht, 0, H_BLOOM_FP);
+	for (i = 0; i < 6; i++) {
+	    h_table_insert(ht, rw[i]);
+	}
+	printf("h_table with bloom (%lu blocks, k %d): romane maybe %d count %d, x maybe "
+	       "%d count %d\n", (unsigned long) ht->bl_n, ht->bl_k,
+	       h_table_maybe(ht, "romane"), h_table_nsearch(ht, "romane"),
+	       h_table_maybe(ht, "x"), h_table_nsearch(ht, "x"));
+	free_h_table(ht);
+	// top 2 strings with 3 counters; romulus takes over the counter of rubens
+	ss_table *ss = new_ss_table(3);
+	ss_node *top[2];
+	char *tw[7] = {"ruber", "romane", "ruber", "rubens", "romulus", "romane",
+		       "ruber"};
+	for (i = 0; i < 7; i++) {
+	    ss_table_insert(ss, tw[i]);
+	}
+	ss_table_top(ss, top, 2);
+	printf("ss_table: %s %d (%d to %d), %s %d (%d to %d), rest at most %d\n",
+	       top[0]->str, top[0]->cnt, top[0]->cnt - top[0]->err, top[0]->cnt,
+	       top[1]->str, top[1]->cnt, top[1]->cnt - top[1]->err, top[1]->cnt,
+	       ss_table_min(ss));
+	free_ss_table(ss);
     }
     // else if there is one argument
     else if (argc == 2) {
@@ -108,11 +2440,19 @@ int main(int argc, char **argv) {
 	    printf("%s\n", HELP_STR);
 	    return 0;
 	}
+	// if it is the benchmark flag, run all benchmarks
+	if (strcmp(argv[1], BENCH_FLAG) == 0) {
+	    return bench__run(NULL);
+	}
 	// else unrecognized; print error and exit
 	fprintf(stderr, "%s: unknown flag \'%s\'. please type \'%s %s\' for usage.\n",
 		PROGNAME, argv[1], PROGNAME, HELP_FLAG);
 	return 0;
     }
+    // else if the benchmark flag is followed by a benchmark name, run only that one
+    else if (argc == 3 && strcmp(argv[1], BENCH_FLAG) == 0) {
+	return bench__run(argv[2]);
+    }
     // else too many arguments; print error and exit
     else {
 	printf("%s: too many arguments. type \'%s %s\' for usage.\n", PROGNAME, PROGNAME, HELP_FLAG);
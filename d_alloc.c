@@ -0,0 +1,202 @@
+/**
+ * d_alloc.c
+ *
+ * pluggable memory allocators for the d_array package. a d_alloc is a set of alloc,
+ * realloc, and free callbacks sharing a context pointer, which a d_array created with
+ * d_array__new_with_alloc uses for its own memory instead of calling malloc, realloc,
+ * and free directly. two allocators are provided: d_alloc__std, which simply wraps
+ * the standard library functions and is used by d_array__new, and d_arena, a bump
+ * allocator from which many short-lived d_arrays can be allocated and then released
+ * all at once with a single call to d_arena__reset.
+ *
+ * source file that contains function definitions.
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "d_alloc.h"
+
+// alignment of every block handed out by a d_arena
+#define D_ARENA__ALIGN sizeof(((d_arena_blk *) NULL)->data[0])
+// rounds n up to a multiple of D_ARENA__ALIGN
+#define D_ARENA__ROUND(n) (((n) + D_ARENA__ALIGN - 1) / D_ARENA__ALIGN * D_ARENA__ALIGN)
+
+// d_alloc__std callbacks; simply call the standard library functions
+static void *d_alloc__std_alloc(void *ctx, size_t n) {
+    return malloc(n);
+}
+static void *d_alloc__std_realloc(void *ctx, void *p, size_t o_n, size_t n) {
+    return realloc(p, n);
+}
+static void d_alloc__std_free(void *ctx, void *p, size_t n) {
+    free(p);
+}
+// allocator that uses malloc, realloc, and free; ctx is unused
+const d_alloc d_alloc__std = {
+    d_alloc__std_alloc, d_alloc__std_realloc, d_alloc__std_free, NULL
+};
+
+// d_arena callbacks; ctx is the d_arena *
+static void *d_arena__alloc_f(void *ctx, size_t n) {
+    return d_arena__malloc((d_arena *) ctx, n);
+}
+static void *d_arena__realloc_f(void *ctx, void *p, size_t o_n, size_t n) {
+    return d_arena__realloc((d_arena *) ctx, p, o_n, n);
+}
+// individual blocks are not freed, except for the last block handed out, which is
+// given back so that a grow after a free can reuse the space
+static void d_arena__free_f(void *ctx, void *p, size_t n) {
+    d_arena *ar = (d_arena *) ctx;
+    if (p != NULL && p == ar->last) {
+	ar->blk->off = (size_t) ((char *) p - (char *) ar->blk->data);
+	ar->last = NULL;
+	ar->last_siz = 0;
+    }
+}
+
+// returns a new block with room for at least n bytes, linked in front of ar->blk
+static d_arena_blk *d_arena__new_blk(d_arena *ar, size_t n) {
+    d_arena_blk *b;
+    // oversized requests get a block of their own size
+    if (n < ar->blk_siz) {
+	n = ar->blk_siz;
+    }
+    b = (d_arena_blk *) malloc(sizeof(d_arena_blk) + n);
+    if (b == NULL) {
+	fprintf(stderr, "%s: malloc error when allocating %lu byte block for d_arena at "
+		"%p\n", D_ARENA__MALLOC_N, (unsigned long) n, (void *) ar);
+	exit(2);
+    }
+    b->siz = n;
+    b->off = 0;
+    b->next = ar->blk;
+    ar->blk = b;
+    return b;
+}
+
+// returns a new d_arena that gets blocks of at least blk_siz bytes at a time from
+// malloc. blk_siz must be positive; D_ARENA__BLK_SIZ is a reasonable default.
+d_arena *d_arena__new(size_t blk_siz) {
+    // if blk_siz < 1, print error and exit
+    if (blk_siz < 1) {
+	fprintf(stderr, "%s: block size must be positive\n", D_ARENA__NEW_N);
+	exit(1);
+    }
+    d_arena *ar = (d_arena *) malloc(sizeof(d_arena));
+    // if ar is NULL, print error and exit
+    if (ar == NULL) {
+	fprintf(stderr, "%s: malloc error when allocating d_arena\n", D_ARENA__NEW_N);
+	exit(2);
+    }
+    ar->blk = NULL;
+    ar->blk_siz = D_ARENA__ROUND(blk_siz);
+    ar->last = NULL;
+    ar->last_siz = 0;
+    ar->al.alloc_f = d_arena__alloc_f;
+    ar->al.realloc_f = d_arena__realloc_f;
+    ar->al.free_f = d_arena__free_f;
+    ar->al.ctx = (void *) ar;
+    // get the first block now so that the first allocation is cheap
+    d_arena__new_blk(ar, ar->blk_siz);
+    return ar;
+}
+
+// returns a pointer to n bytes from the arena, aligned for any type. the memory stays
+// valid until d_arena__reset or d_arena__free is called on the arena.
+void *d_arena__malloc(d_arena *ar, size_t n) {
+    // if ar is NULL, print error and exit
+    if (ar == NULL) {
+	fprintf(stderr, "%s: cannot allocate from null d_arena\n", D_ARENA__MALLOC_N);
+	exit(1);
+    }
+    d_arena_blk *b = ar->blk;
+    size_t r_n = D_ARENA__ROUND(n);
+    // if the current block is out of room, start a new one
+    if (b->siz - b->off < r_n) {
+	b = d_arena__new_blk(ar, r_n);
+    }
+    void *p = (char *) b->data + b->off;
+    b->off += r_n;
+    ar->last = p;
+    ar->last_siz = n;
+    return p;
+}
+
+// resizes the o_n byte block p from the arena to n bytes. if p was the last block
+// handed out by the arena and the current arena block has room, p is resized in place;
+// otherwise a new block is taken from the arena and the old contents copied to it.
+void *d_arena__realloc(d_arena *ar, void *p, size_t o_n, size_t n) {
+    // if ar is NULL, print error and exit
+    if (ar == NULL) {
+	fprintf(stderr, "%s: cannot reallocate from null d_arena\n", D_ARENA__REALLOC_N);
+	exit(1);
+    }
+    // realloc(NULL, n) is malloc(n)
+    if (p == NULL) {
+	return d_arena__malloc(ar, n);
+    }
+    // if p is the last block, try to move the end of p in place
+    if (p == ar->last) {
+	size_t p_o = (size_t) ((char *) p - (char *) ar->blk->data);
+	if (ar->blk->siz - p_o >= D_ARENA__ROUND(n)) {
+	    ar->blk->off = p_o + D_ARENA__ROUND(n);
+	    ar->last_siz = n;
+	    return p;
+	}
+    }
+    // else shrinking is a no-op, and growing needs a new block and a copy
+    if (n <= o_n) {
+	return p;
+    }
+    void *q = d_arena__malloc(ar, n);
+    memcpy(q, p, o_n);
+    return q;
+}
+
+// releases everything allocated from the arena at once, keeping only the current block
+// for reuse. any d_arrays that were allocated from the arena become invalid.
+void d_arena__reset(d_arena *ar) {
+    // if ar is NULL, print error and exit
+    if (ar == NULL) {
+	fprintf(stderr, "%s: cannot reset null d_arena\n", D_ARENA__RESET_N);
+	exit(1);
+    }
+    d_arena_blk *b, *b_n;
+    // free all but the current block
+    b = ar->blk->next;
+    while (b != NULL) {
+	b_n = b->next;
+	free(b);
+	b = b_n;
+    }
+    ar->blk->next = NULL;
+    ar->blk->off = 0;
+    ar->last = NULL;
+    ar->last_siz = 0;
+}
+
+// frees the arena and all memory allocated from it
+void d_arena__free(d_arena *ar) {
+    // if ar is NULL, print error and exit
+    if (ar == NULL) {
+	fprintf(stderr, "%s: cannot free null pointer\n", D_ARENA__FREE_N);
+	exit(1);
+    }
+    d_arena_blk *b, *b_n;
+    b = ar->blk;
+    while (b != NULL) {
+	b_n = b->next;
+	free(b);
+	b = b_n;
+    }
+    free(ar);
+}
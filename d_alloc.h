@@ -0,0 +1,112 @@
+/**
+ * d_alloc.h
+ *
+ * pluggable memory allocators for the d_array package. a d_alloc is a set of alloc,
+ * realloc, and free callbacks sharing a context pointer, which a d_array created with
+ * d_array__new_with_alloc uses for its own memory instead of calling malloc, realloc,
+ * and free directly. two allocators are provided: d_alloc__std, which simply wraps
+ * the standard library functions and is used by d_array__new, and d_arena, a bump
+ * allocator from which many short-lived d_arrays can be allocated and then released
+ * all at once with a single call to d_arena__reset.
+ *
+ * header file that contains declarations for functions, macros, and the structs.
+ *
+ * sample usage:
+ *
+ * int i, j;
+ * d_arena *ar;
+ * d_array *da;
+ * ar = d_arena__new(D_ARENA__BLK_SIZ);
+ * for (i = 0; i < 1000; i++) {
+ *     da = d_array__new_with_alloc(DEFAULT_SIZ, D_ARRAY__INT, d_arena__al(ar));
+ *     for (j = 0; j < 100; j++) {
+ *         d_array__append(da, &j);
+ *     }
+ *     // ...use da, but do not d_array__free it...
+ *     d_arena__reset(ar);
+ * }
+ * d_arena__free(ar);
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#ifndef D_ALLOC_H
+#define D_ALLOC_H
+// include stddef.h for size_t
+#include <stddef.h>
+// default size of each block of memory a d_arena gets from malloc (64 KiB)
+#define D_ARENA__BLK_SIZ 65536
+// user function names
+#define D_ARENA__NEW_N "d_arena__new"
+#define D_ARENA__MALLOC_N "d_arena__malloc"
+#define D_ARENA__REALLOC_N "d_arena__realloc"
+#define D_ARENA__RESET_N "d_arena__reset"
+#define D_ARENA__FREE_N "d_arena__free"
+// allocator interface
+struct d_alloc {
+    // returns pointer to n bytes of memory, or NULL on failure
+    void *(*alloc_f)(void *ctx, size_t n);
+    // resizes the o_n byte block p (returned by alloc_f or realloc_f) to n bytes,
+    // returning a pointer to the resized block (which may move), or NULL on failure
+    void *(*realloc_f)(void *ctx, void *p, size_t o_n, size_t n);
+    // releases the n byte block p
+    void (*free_f)(void *ctx, void *p, size_t n);
+    // context passed to each of the callbacks above
+    void *ctx;
+};
+typedef struct d_alloc d_alloc;
+// allocator that uses malloc, realloc, and free; ctx is unused
+extern const d_alloc d_alloc__std;
+// block of memory owned by a d_arena
+struct d_arena_blk {
+    // next (older) block
+    struct d_arena_blk *next;
+    // usable bytes in the block, bytes in use
+    size_t siz, off;
+    // start of usable bytes (aligned for any type)
+    union {
+	long l;
+	double d;
+	void *p;
+	long double ld;
+    } data[];
+};
+typedef struct d_arena_blk d_arena_blk;
+// bump ("arena") allocator
+struct d_arena {
+    // current block (head of block list)
+    d_arena_blk *blk;
+    // default no. usable bytes in each new block
+    size_t blk_siz;
+    // last block handed out, and its size, which can be resized or freed in place
+    void *last;
+    size_t last_siz;
+    // d_alloc that allocates from this arena; pass d_arena__al(ar) to
+    // d_array__new_with_alloc
+    d_alloc al;
+};
+typedef struct d_arena d_arena;
+// returns a new d_arena that gets blocks of at least blk_siz bytes at a time from
+// malloc. blk_siz must be positive; D_ARENA__BLK_SIZ is a reasonable default.
+d_arena *d_arena__new(size_t blk_siz);
+// returns a pointer to n bytes from the arena, aligned for any type. the memory stays
+// valid until d_arena__reset or d_arena__free is called on the arena.
+void *d_arena__malloc(d_arena *ar, size_t n);
+// resizes the o_n byte block p from the arena to n bytes. if p was the last block
+// handed out by the arena and the current arena block has room, p is resized in place;
+// otherwise a new block is taken from the arena and the old contents copied to it.
+void *d_arena__realloc(d_arena *ar, void *p, size_t o_n, size_t n);
+// releases everything allocated from the arena at once, keeping only the current block
+// for reuse. any d_arrays that were allocated from the arena become invalid.
+void d_arena__reset(d_arena *ar);
+// frees the arena and all memory allocated from it
+void d_arena__free(d_arena *ar);
+// returns the d_alloc that allocates from ar, which is valid as long as ar is
+#define d_arena__al(ar) (&(ar)->al)
+
+#endif /* D_ALLOC_H */
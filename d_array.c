@@ -45,6 +45,33 @@
  *
  * Changelog:
  *
+ * 10-17-2026
+ *
+ * added d_array__append_n, d_array__insert_range, and d_array__remove_range, which
+ * resize at most once and shift the tail of the d_array with a single memmove instead
+ * of one memcpy per element per inserted or removed element. added
+ * d_array__new_with_alloc; d_array__new now calls it with d_alloc__std, and all memory
+ * for the d_array struct and its elements is managed through da->__al. moved all
+ * resizing into d_array__resize, d_array__grow, and d_array__shrink, which follow the
+ * per-d_array growth policy da->__pol and update the counters da->n_realloc and
+ * da->b_moved. added d_array__reserve, d_array__shrink_to_fit, and d_array__set_policy.
+ * single element insert and remove now shift the tail with one memmove. shrinking
+ * never takes the capacity of a d_array to 0 anymore. added d_array__remove_if and
+ * d_array__remove_many, which compact a d_array in one stable pass. added the d_writer
+ * interface, d_writer__file, d_writer__buf, and d_array__write, which formats elements
+ * into a stack buffer with the new __wrstr_el__* functions and passes the buffer to a
+ * writer, without a malloc per element. d_array__tostr is now d_array__write into a
+ * growing string. __tostr_el__int uses __wrstr_el__int and no longer overflows its
+ * string for INT_MIN. added d_array__set_wrstr_el. the __wrstr_el__* functions for
+ * int, long, and double now use d_fmt, and __tostr_el__long and __tostr_el__double,
+ * which used to return NULL, now write their element like __tostr_el__int does.
+ * the names of d_array__get, d_array__getcpy, and d_array__set are in parentheses in
+ * their definitions, so that the D_ARRAY__RELEASE macros do not replace them, and the
+ * error message of d_array__get prints its size_t index correctly.
+ * added d_array__sort, which LSD radix sorts the default numeric types when no
+ * comparator is given, d_array__sort_mt, which sorts runs on their own threads and
+ * merges them on threads too, and d_array__lower_bound and d_array__bsearch.
+ *
  * 12-02-2018
  *
  * updated comments to reflect changed line spacing in d_array.h
@@ -110,52 +137,121 @@
  *
  */
 
+#include <pthread.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "d_array.h"
+// number formatting for the default __wrstr_el__* functions
+#include "d_fmt.h"
 
-// writes an integer element of a d_array to a string, and returns char *
-// returns NULL in case of error
-char *__tostr_el__int(const void *e) {
-    // integer at e, length of int, copy of int at e
-    int k, l_k, c_k;
-    k = *((int *) e);
-    l_k = 0;
-    c_k = k;
-    // special cases:
-    // if k == 0, increment l_k (loop will not be triggered)
-    if (k == 0) {
-	l_k++;
-    }
-    // else if integer is negative, increment l_k and eliminate sign of c_k
-    else if (k < 0) {
-	l_k++;
-	c_k = ~c_k + 0x1;
-    }
-    // get length of integer
-    while (c_k > 0) {
-	c_k = c_k / 10;
-	l_k++;
-    }
-    // create string of length l_k
-    char *s;
-    s = (char *) malloc(l_k + 1);
+// size of the buffer d_array__write formats elements into before handing them to its
+// d_writer
+#define D_ARRAY__WBUF_SIZ BUFSIZ
+
+// resizes da->a to hold n_max elements through the allocator of da, and updates
+// da->max_siz and the resize counters of da. fn is the name of the calling function,
+// used in the error message if the allocator fails.
+static void d_array__resize(d_array *da, size_t n_max, const char *fn) {
+    void *a;
+    a = da->__al->realloc_f(da->__al->ctx, da->a, da->max_siz * da->e_siz,
+			    n_max * da->e_siz);
+    // if a is NULL, print error and exit
+    if (a == NULL) {
+	fprintf(stderr, "%s: realloc failure resizing d_array at %p to %lu elements\n",
+		fn, da, (unsigned long) n_max);
+	exit(2);
+    }
+    da->n_realloc++;
+    // if the memory block moved, the elements in it were copied
+    if (a != da->a) {
+	da->b_moved += da->siz * da->e_siz;
+    }
+    da->a = a;
+    da->max_siz = n_max;
+}
+
+// grows the capacity of da according to its growth policy until it can hold n elements,
+// resizing at most once. each step multiplies the capacity by da->__pol.g_fac, adding
+// at least da->__pol.g_min elements. does nothing if da can already hold n elements.
+static void d_array__grow(d_array *da, size_t n, const char *fn) {
+    size_t n_max, g;
+    if (n <= da->max_siz) {
+	return;
+    }
+    n_max = da->max_siz;
+    while (n_max < n) {
+	g = (size_t) (n_max * da->__pol.g_fac) - n_max;
+	if (g < da->__pol.g_min) {
+	    g = da->__pol.g_min;
+	}
+	if (g < 1) {
+	    g = 1;
+	}
+	n_max += g;
+    }
+    d_array__resize(da, n_max, fn);
+}
+
+// shrinks the capacity of da according to its growth policy, resizing at most once.
+// while da->siz <= da->max_siz * da->__pol.s_thr, the capacity is divided by
+// da->__pol.g_fac (or reduced by da->__pol.g_min if that is more), but always leaves
+// room for at least one more element, so that an append right after a shrink never
+// has to grow the d_array again. does nothing if da->__pol.s_thr is 0.
+static void d_array__shrink(d_array *da, const char *fn) {
+    size_t n_max, m;
+    if (da->__pol.s_thr <= 0) {
+	return;
+    }
+    n_max = da->max_siz;
+    while (da->siz <= n_max * da->__pol.s_thr) {
+	m = (size_t) (n_max / da->__pol.g_fac);
+	if (n_max - m < da->__pol.g_min) {
+	    m = (n_max > da->__pol.g_min) ? n_max - da->__pol.g_min : 0;
+	}
+	if (m < da->siz + 1) {
+	    m = da->siz + 1;
+	}
+	if (m >= n_max) {
+	    break;
+	}
+	n_max = m;
+    }
+    if (n_max != da->max_siz) {
+	d_array__resize(da, n_max, fn);
+    }
+}
+
+// writes an element of a d_array into a new string with the __wrstr_el function __wef,
+// for the default __tostr_el__* functions that need a string of their own. fn is the
+// name of the calling function, used in the error message if malloc fails.
+static char *d_array__el_str(size_t (*__wef)(char *, size_t, const void *),
+			     const void *e, const char *fn) {
+    // buffer large enough for any element of a default type
+    char b[D_FMT__BUF_SIZ], *s;
+    size_t l_e;
+    l_e = __wef(b, sizeof(b), e);
+    // create string of length l_e
+    s = (char *) malloc(l_e + 1);
     // if s is NULL, print error and exit
     if (s == NULL) {
-	fprintf(stderr, "%s: malloc failure for element at %p\n", __TOSTR_EL__INT_N, e);
+	fprintf(stderr, "%s: malloc failure for element at %p\n", fn, e);
 	exit(2);
     }
-    // use sprintf to write int to s; if no. characters returned <= 0,
-    // return NULL
-    if (sprintf(s, "%d", k) <= 0) {
-	return NULL;
-    }
+    memcpy(s, b, l_e);
     // write null-terminating character and return
-    *(s + l_k) = '\0';
+    *(s + l_e) = '\0';
     return s;
 }
+
+// writes an integer element of a d_array to a string, and returns char *
+// returns NULL in case of error. d_array__write and d_array__tostr do not call this;
+// they use __wrstr_el__int, which does not allocate.
+char *__tostr_el__int(const void *e) {
+    return d_array__el_str(__wrstr_el__int, e, __TOSTR_EL__INT_N);
+}
 // simply returns e cast to char *
 char *__tostr_el__char(const void *e) {
     return (char *) e;
@@ -164,13 +260,299 @@ char *__tostr_el__char(const void *e) {
 char *__tostr_el__char__ptr(const void *e) {
     return *((char **) e);
 }
+// writes a long element of a d_array to a string, like __tostr_el__int
 char *__tostr_el__long(const void *e) {
-    return NULL;
+    return d_array__el_str(__wrstr_el__long, e, __TOSTR_EL__LONG_N);
 }
+// writes a double element of a d_array to a string, like __tostr_el__int
 char *__tostr_el__double(const void *e) {
+    return d_array__el_str(__wrstr_el__double, e, __TOSTR_EL__DOUBLE_N);
+}
+
+// writes the int at e in decimal into s, which has room for n chars, without a
+// null-terminating character. returns the length of the string; if it is greater than
+// n, nothing was written.
+size_t __wrstr_el__int(char *s, size_t n, const void *e) {
+    char b[D_FMT__BUF_SIZ];
+    size_t l_k;
+    // format straight into s if it is always large enough
+    if (n >= D_FMT__BUF_SIZ) {
+	return d_fmt__ltoa(s, *((const int *) e));
+    }
+    l_k = d_fmt__ltoa(b, *((const int *) e));
+    if (l_k <= n) {
+	memcpy(s, b, l_k);
+    }
+    return l_k;
+}
+// writes the char at e into s
+size_t __wrstr_el__char(char *s, size_t n, const void *e) {
+    if (n >= 1) {
+	*s = *((const char *) e);
+    }
+    return 1;
+}
+// writes the string pointed to by the char * at e into s
+size_t __wrstr_el__char__ptr(char *s, size_t n, const void *e) {
+    const char *c = *((char * const *) e);
+    size_t l_c = strlen(c);
+    if (l_c <= n) {
+	memcpy(s, c, l_c);
+    }
+    return l_c;
+}
+// writes the long at e in decimal into s
+size_t __wrstr_el__long(char *s, size_t n, const void *e) {
+    char b[D_FMT__BUF_SIZ];
+    size_t l_k;
+    if (n >= D_FMT__BUF_SIZ) {
+	return d_fmt__ltoa(s, *((const long *) e));
+    }
+    l_k = d_fmt__ltoa(b, *((const long *) e));
+    if (l_k <= n) {
+	memcpy(s, b, l_k);
+    }
+    return l_k;
+}
+// writes the double at e into s, using the fewest digits that read back as the same
+// double (see d_fmt__dtoa)
+size_t __wrstr_el__double(char *s, size_t n, const void *e) {
+    char b[D_FMT__BUF_SIZ];
+    size_t l_d;
+    if (n >= D_FMT__BUF_SIZ) {
+	return d_fmt__dtoa(s, *((const double *) e));
+    }
+    l_d = d_fmt__dtoa(b, *((const double *) e));
+    if (l_d <= n) {
+	memcpy(s, b, l_d);
+    }
+    return l_d;
+}
+
+// returns the __wrstr_el__* function matching the default __tostr_el__* function
+// __tef, or NULL if __tef is not one of the defaults
+static size_t (*d_array__find_wrstr_el(char *(*__tef)(const void *)))
+    (char *, size_t, const void *) {
+    if (__tef == __tostr_el__int) {
+	return __wrstr_el__int;
+    }
+    if (__tef == __tostr_el__char) {
+	return __wrstr_el__char;
+    }
+    if (__tef == __tostr_el__char__ptr) {
+	return __wrstr_el__char__ptr;
+    }
+    if (__tef == __tostr_el__long) {
+	return __wrstr_el__long;
+    }
+    if (__tef == __tostr_el__double) {
+	return __wrstr_el__double;
+    }
     return NULL;
 }
 
+// d_writer callback for d_writer__file; ctx is the FILE *
+static size_t d_writer__file_f(void *ctx, const char *s, size_t n) {
+    return fwrite(s, 1, n, (FILE *) ctx);
+}
+// returns a d_writer that writes to the stream f with fwrite
+d_writer d_writer__file(FILE *f) {
+    d_writer w;
+    w.write_f = d_writer__file_f;
+    w.ctx = (void *) f;
+    return w;
+}
+
+// d_writer callback for d_writer__buf; ctx is the d_wbuf *. copies as much as fits
+// (keeping room for the null-terminating character) but always counts all n chars
+static size_t d_writer__buf_f(void *ctx, const char *s, size_t n) {
+    d_wbuf *wb = (d_wbuf *) ctx;
+    size_t n_c;
+    if (wb->len < wb->max) {
+	n_c = wb->max - 1 - wb->len;
+	n_c = (n < n_c) ? n : n_c;
+	memcpy(wb->s + wb->len, s, n_c);
+	*(wb->s + wb->len + n_c) = '\0';
+    }
+    wb->len += n;
+    return n;
+}
+// sets up wb to write into the caller's buffer s of max chars, and returns a d_writer
+// that writes into it. like snprintf, output that does not fit is cut off, s is always
+// null-terminated (if max > 0), and wb->len counts every char written, so the output
+// was cut off if wb->len >= max.
+d_writer d_writer__buf(d_wbuf *wb, char *s, size_t max) {
+    d_writer w;
+    wb->s = s;
+    wb->max = max;
+    wb->len = 0;
+    if (max > 0) {
+	*s = '\0';
+    }
+    w.write_f = d_writer__buf_f;
+    w.ctx = (void *) wb;
+    return w;
+}
+
+// growing heap string used by d_array__tostr
+struct d_array__sbuf {
+    char *s;
+    size_t max, len;
+    // d_array being written, for error messages
+    d_array *da;
+};
+// d_writer callback for d_array__tostr; ctx is the struct d_array__sbuf *. doubles the
+// string until it has room for n more chars and a null-terminating character
+static size_t d_array__sbuf_f(void *ctx, const char *s, size_t n) {
+    struct d_array__sbuf *sb = (struct d_array__sbuf *) ctx;
+    if (sb->len + n + 1 > sb->max) {
+	while (sb->len + n + 1 > sb->max) {
+	    sb->max = 2 * sb->max;
+	}
+	sb->s = (char *) realloc((void *) sb->s, sb->max);
+	// if sb->s is NULL, print error and exit
+	if (sb->s == NULL) {
+	    fprintf(stderr, "%s: realloc error managing memory for d_array at %p\n",
+		    D_ARRAY__TOSTR_N, sb->da);
+	    exit(2);
+	}
+    }
+    memcpy(sb->s + sb->len, s, n);
+    sb->len += n;
+    return n;
+}
+
+// given a d_array * da, size_t si and ei, writes elements si to ei - 1 in string form
+// to the writer w, in the same format as d_array__tostr. elements are formatted into a
+// stack buffer by da's __wrstr_el function (see d_array__set_wrstr_el), which for the
+// default types is picked automatically, and the buffer is handed to w whenever it
+// fills up, so there is no malloc per element. if da has no __wrstr_el function, its
+// __tostr_el function is used instead, and each string it returns is freed. can use
+// ALL__(da) for si and ei. returns 0 on success, -1 if w did not accept all chars.
+int d_array__write(d_array *da, size_t si, size_t ei, const d_writer *w) {
+    // if da or w is NULL, print error and exit
+    if (da == NULL || w == NULL || w->write_f == NULL) {
+	fprintf(stderr, "%s: cannot write null d_array or to null writer\n",
+		D_ARRAY__WRITE_N);
+	exit(1);
+    }
+    // if si > ei or ei > da->siz, print error and exit
+    if (si > ei || ei > da->siz) {
+	fprintf(stderr,
+		"%s: cannot write elements outside of array bounds of d_array at %p\n",
+		D_ARRAY__WRITE_N, da);
+	exit(1);
+    }
+    // function pointers for formatting an element into a buffer or as a new string
+    size_t (*__wrstr_el)(char *, size_t, const void *);
+    char *(*__tostr_el)(const void *);
+    __tostr_el = da->__tostr_el;
+    __wrstr_el = da->__wrstr_el;
+    if (__wrstr_el == NULL) {
+	__wrstr_el = d_array__find_wrstr_el(__tostr_el);
+    }
+    // if both are NULL, we cannot convert elements to strings; print error and exit
+    if (__wrstr_el == NULL && __tostr_el == NULL) {
+	fprintf(stderr, "%s: d_array at %p does not contain valid __tostr_el function\n",
+		D_ARRAY__WRITE_N, da);
+	exit(1);
+    }
+    // output buffer, da->a as char *, string from __tostr_el, oversized element buffer
+    char b[D_ARRAY__WBUF_SIZ], *ca, *ce, *cb;
+    // no. chars in b, length of element string, space left in b
+    size_t b_o, s_ce, b_r;
+    ca = (char *) da->a;
+    b_o = 0;
+// hands the chars in b to w, returning -1 from d_array__write if w fails
+#define D_ARRAY__FLUSH_B() \
+    do { \
+	if (b_o > 0 && w->write_f(w->ctx, b, b_o) != b_o) { \
+	    return -1; \
+	} \
+	b_o = 0; \
+    } while (0)
+    if (da->__pr_c != '\0') {
+	b[b_o++] = da->__pr_c;
+    }
+    for (; si < ei; si++) {
+	if (__wrstr_el != NULL) {
+	    b_r = sizeof(b) - b_o;
+	    s_ce = __wrstr_el(b + b_o, b_r, ca + si * da->e_siz);
+	    // if the element did not fit, flush and try again with an empty buffer
+	    if (s_ce > b_r) {
+		D_ARRAY__FLUSH_B();
+		s_ce = __wrstr_el(b, sizeof(b), ca + si * da->e_siz);
+		// if it is larger than b, format it into a buffer of its own
+		if (s_ce > sizeof(b)) {
+		    cb = (char *) malloc(s_ce);
+		    // if cb is NULL, print error and exit
+		    if (cb == NULL) {
+			fprintf(stderr, "%s: malloc failure for element at %p in "
+				"d_array at %p\n", D_ARRAY__WRITE_N,
+				ca + si * da->e_siz, da);
+			exit(2);
+		    }
+		    __wrstr_el(cb, s_ce, ca + si * da->e_siz);
+		    if (w->write_f(w->ctx, cb, s_ce) != s_ce) {
+			free(cb);
+			return -1;
+		    }
+		    free(cb);
+		    s_ce = 0;
+		}
+	    }
+	    b_o += s_ce;
+	}
+	else {
+	    ce = __tostr_el((void *) (ca + si * da->e_siz));
+	    // if ce is NULL, print error and exit
+	    if (ce == NULL) {
+		fprintf(stderr, "%s: write error with element at %p in d_array at %p\n",
+			D_ARRAY__WRITE_N, ca + si * da->e_siz, da);
+		exit(2);
+	    }
+	    s_ce = strlen(ce);
+	    // flush by hand instead of with D_ARRAY__FLUSH_B, since ce must be freed if
+	    // w fails
+	    if (s_ce > sizeof(b) - b_o) {
+		if (b_o > 0 && w->write_f(w->ctx, b, b_o) != b_o) {
+		    free(ce);
+		    return -1;
+		}
+		b_o = 0;
+	    }
+	    // strings larger than b are handed to w directly
+	    if (s_ce > sizeof(b)) {
+		if (w->write_f(w->ctx, ce, s_ce) != s_ce) {
+		    free(ce);
+		    return -1;
+		}
+	    }
+	    else {
+		memcpy(b + b_o, ce, s_ce);
+		b_o += s_ce;
+	    }
+	    free(ce);
+	}
+	// write separator after every element but the last
+	if (da->__sep != '\0' && si < ei - 1) {
+	    if (b_o == sizeof(b)) {
+		D_ARRAY__FLUSH_B();
+	    }
+	    b[b_o++] = da->__sep;
+	}
+    }
+    if (da->__ps_c != '\0') {
+	if (b_o == sizeof(b)) {
+	    D_ARRAY__FLUSH_B();
+	}
+	b[b_o++] = da->__ps_c;
+    }
+    D_ARRAY__FLUSH_B();
+#undef D_ARRAY__FLUSH_B
+    return 0;
+}
+
 // given a d_array * da, size_t si and ei, will write elements si to ei - 1 in string form
 // according to da's __tostr_el function, element separator sep, pre- and post-char pp, and
 // return a char * to that string.
@@ -191,110 +573,51 @@ char *d_array__tostr(d_array *da, size_t si, size_t ei) {
 		D_ARRAY__TOSTR_N, da);
 	exit(1);
     }
-    // function pointer for da->__tostr_el
-    char *(*__tostr_el)(const void *);
-    __tostr_el = da->__tostr_el;
-    // if NULL, we do not have the required function to convert each element to string,
-    // so we can only print error and exit
-    if (__tostr_el == NULL) {
+    // if there is no way to convert elements to strings, print error and exit
+    if (da->__tostr_el == NULL && da->__wrstr_el == NULL) {
 	fprintf(stderr, "%s: d_array at %p does not contain valid __tostr_el function\n",
 		D_ARRAY__TOSTR_N, da);
 	exit(1);
     }
-    // char * for string, da->a cast as char *, char * to individual element string
-    char *s, *ca, *ce;
-    // max capacity of string, current pointer offset, length of string at ce
-    // current pointer offset no. bytes s needs to be offset for new write
-    size_t s_max, s_o, s_ce;
-    // offset for width of sep, pr_c, or ps_c
-    int s_spo;
-    s_spo = 0;
-    // start at BUFSIZ, trade memory for speed
-    s_max = BUFSIZ;
-    // offset at 0
-    s_o = 0;
-    // allocate space for buffer
-    s = (char *) malloc(s_max);
-    // cast da->a to char *
-    ca = (char *) da->a;
-    // if da->__pr_c != '\0', write it to s and increment s_o
-    if (da->__pr_c != '\0') {
-	*s = da->__pr_c;
-	s_o++;
-    }
-    // using si as counter, while si < ei
-    while (si < ei) {
-	// get char * to string version of element at si
-	ce = __tostr_el((void *) (ca + si * da->e_siz));
-	// if ce is NULL, print error and exit
-	if (ce == NULL) {
-	    fprintf(stderr, "%s: write error with element at %p in d_array at %p\n",
-		    D_ARRAY__TOSTR_N, ca + si * da->e_siz, da);
-	    exit(2);
-	}
-	// get length of ce; set to 1 if da->__tostr_el == __tostr_el__char
-	// optimization only for characters
-	if (da->__tostr_el == __tostr_el__char) {
-	    s_ce = 1;
-	}
-	else {
-	    s_ce = strlen(ce);
-	}
-	// if __sep is not '\0' and si < ei - 1, or __ps_c is not '\0' and si == ei - 1,
-	// then set s_spo to 1
-	if ((da->__sep != '\0' && si < ei - 1) ||
-	    (si == ei - 1 && da->__ps_c != '\0')) { s_spo = 1; }
-	// if s_max - s_o - s_spo - 1 (null char) < s_ce, not enough space: realloc
-	// we use a while loop because in case of an arbitrary length string, it can be
-	// much longer than the s_max, and we need the additional or condition
-	// s_o >= s_max - s_spo - 1 because when s_ce == 1, and s_max - s_o == 1, if
-	// s_spo == 1, then lhs will be negative and there will be unsigned overflow.
-	// the condition s_o >= s_max - s_spo - 1 is sufficient.
-	while (s_o >= s_max - 2 || s_max - s_o - s_spo - 1 < s_ce) {
-	    // double size of s_max
-	    s_max = 2 * s_max;
-	    // realloc
-	    s = (char *) realloc((void *) s, s_max);
-	    // if s is NULL, print error and exit
-	    if (s == NULL) {
-		fprintf(stderr, "%s: realloc error managing memory for d_array at %p\n",
-			D_ARRAY__TOSTR_N, da);
-		exit(2);
-	    }
-	}
-	// write s_ce characters at s + s_o, and add s_ce to s_o
-	strncpy(s + s_o, ce, s_ce);
-	s_o = s_o + s_ce;
-	// if s_spo != 0
-	if (s_spo != 0) {
-	    // if __sep != '\0' and si < ei - 1, write __sep
-	    if (da->__sep != '\0' && si < ei - 1) {
-		*(s + s_o) = da->__sep;
-	    }
-	    // else if __ps_c != '\0;' and si == ei - 1, write __ps_c
-	    else if (da->__ps_c != '\0' && si == ei - 1) {
-		*(s + s_o) = da->__ps_c;
-	    }
-	    // reset s_spo to 0
-	    s_spo = 0;
-	    // increment s_o
-	    s_o++;
-	}
-	// if the element type is not char or char *, free ce (char or char * do
-	// not malloc extra memory)
-	if ((__tostr_el != __tostr_el__char) && (__tostr_el != __tostr_el__char__ptr)) {
-	    free(ce);
-	}
-	// increment si
-	si++;
+    // string that grows as d_array__write writes into it; start at BUFSIZ, trade
+    // memory for speed
+    struct d_array__sbuf sb;
+    d_writer w;
+    sb.max = BUFSIZ;
+    sb.len = 0;
+    sb.da = da;
+    sb.s = (char *) malloc(sb.max);
+    // if sb.s is NULL, print error and exit
+    if (sb.s == NULL) {
+	fprintf(stderr, "%s: malloc error managing memory for d_array at %p\n",
+		D_ARRAY__TOSTR_N, da);
+	exit(2);
     }
-    // set s + s_o to '\0'
-    *(s + s_o) = '\0';
-    // realloc to size s_o + 1
-    s = (char *) realloc((void *) s, s_o + 1);
-    // return s
-    return s;
+    w.write_f = d_array__sbuf_f;
+    w.ctx = (void *) &sb;
+    // the string writer never fails (it exits instead)
+    d_array__write(da, si, ei, &w);
+    // set sb.s + sb.len to '\0' and return the string
+    *(sb.s + sb.len) = '\0';
+    return sb.s;
 }
+
+// sets the function d_array__write and d_array__tostr use to format an element of da
+// into a buffer. __wef(s, n, e) must write the element at e into s, which has room for
+// n chars, without a null-terminating character, and return the length of the element
+// as a string, writing nothing if that is greater than n. the default types get one
+// automatically; for user-defined types, setting one avoids the malloc and free per
+// element that __tostr_el requires. pass NULL to go back to using __tostr_el.
+void d_array__set_wrstr_el(d_array *da, size_t (*__wef)(char *, size_t, const void *)) {
+    // if da is NULL, print error and exit
+    if (da == NULL) {
+	fprintf(stderr, "%s: cannot set __wrstr_el of null d_array\n",
+		D_ARRAY__SET_WRSTR_EL_N);
+	exit(1);
+    }
+    da->__wrstr_el = __wef;
+}
+
 // creates a new d_array; if DEFAULT_SIZ is given then number of elements before resize
 // is 10 by default, while with AUTO_SIZ the number will be 1, similar to Java's ArrayList.
 // n is the no. elements that can be added before a resize is needed, e is the size of each
@@ -312,6 +635,16 @@ char *d_array__tostr(d_array *da, size_t si, size_t ei) {
 // it is recommended that user-defined __tef and sep/pp be combined into a macro
 d_array *d_array__new(size_t n, size_t e, char *(*__tef)(const void *), const char *__t,
 		      char __sep, char __pr_c, char __ps_c) {
+    return d_array__new_with_alloc(n, e, __tef, __t, __sep, __pr_c, __ps_c, &d_alloc__std);
+}
+
+// same as d_array__new, except that the d_array struct and all the memory for its
+// elements come from the allocator al instead of from malloc. al must stay valid for as
+// long as the d_array is in use. ex. with a d_arena *ar from d_alloc.h,
+// d_array__new_with_alloc(DEFAULT_SIZ, D_ARRAY__INT, d_arena__al(ar))
+d_array *d_array__new_with_alloc(size_t n, size_t e, char *(*__tef)(const void *),
+				 const char *__t, char __sep, char __pr_c, char __ps_c,
+				 const d_alloc *al) {
     // if n < 1, print error and exit
     if (n < 1) {
 	fprintf(stderr,
@@ -328,15 +661,21 @@ d_array *d_array__new(size_t n, size_t e, char *(*__tef)(const void *), const ch
 	fprintf(stderr, "%s: cannot pass NULL as a type\n", D_ARRAY__NEW_N);
 	exit(1);
     }
+    // if al or any of its callbacks are NULL, print error and exit
+    if (al == NULL || al->alloc_f == NULL || al->realloc_f == NULL || al->free_f == NULL) {
+	fprintf(stderr, "%s: cannot pass NULL allocator or allocator callback\n",
+		D_ARRAY__NEW_WITH_ALLOC_N);
+	exit(1);
+    }
     // create new d_array struct
-    d_array *da = (d_array *) malloc(sizeof(d_array));
+    d_array *da = (d_array *) al->alloc_f(al->ctx, sizeof(d_array));
     // if da is NULL, print error and exit
     if (da == NULL) {
 	fprintf(stderr, "%s: malloc error when allocating d_array\n", D_ARRAY__NEW_N);
 	exit(2);
     }
     // new e array with n elements, currently uninitialized, element of size e
-    da->a = malloc(n * e);
+    da->a = al->alloc_f(al->ctx, n * e);
     // if a is NULL, print error and exit
     if (da->a == NULL) {
 	fprintf(stderr, "%s: malloc error when allocating memory at %p->a\n",
@@ -351,6 +690,12 @@ d_array *d_array__new(size_t n, size_t e, char *(*__tef)(const void *), const ch
     da->__sep = __sep;
     da->__pr_c = __pr_c;
     da->__ps_c = __ps_c;
+    da->__al = al;
+    // the default types get their __wrstr_el when they are written
+    da->__wrstr_el = NULL;
+    da->__pol = (d_array_policy) {D_ARRAY__POLICY__DEFAULT};
+    da->n_realloc = 0;
+    da->b_moved = 0;
     // return pointer
     return da;
 }
@@ -380,21 +725,13 @@ void d_array__insert(d_array *da, void *e, size_t i) {
 	exit(1);
     }
     // insert element e at index i in da->a (i < da->siz)
-    // counter, record size of da->a (da->siz), record size of element (da->e_siz)
-    size_t c, n, e_siz;
+    // record size of da->a (da->siz), record size of element (da->e_siz)
+    size_t n, e_siz;
     n = da->siz;
     e_siz = da->e_siz;
-    // if da->siz == da->max_siz, double array size
+    // if da->siz == da->max_siz, grow according to the growth policy of da
     if (n == da->max_siz) {
-	da->max_siz *= 2;
-	da->a = realloc(da->a, da->max_siz * e_siz);
-	// if da->a is NULL, print error and exit
-	if (da->a == NULL) {
-	    fprintf(stderr,
-		    "%s: realloc failure inserting element at %p into d_array at %p\n",
-		    D_ARRAY__INSERT_N, e, da);
-	    exit(2);
-	}
+	d_array__grow(da, n + 1, D_ARRAY__INSERT_N);
     }
     // we cannot do pointer arithmetic on void pointers, so we must first convert it to
     // char * so that we will be adding k bytes to it if we do for some initialized char
@@ -403,12 +740,9 @@ void d_array__insert(d_array *da, void *e, size_t i) {
     char *ca = (char *) da->a;
     // increment da->siz
     ++da->siz;
-    // for each element i to da->siz - 1, shift them to the right by 1
-    // we need the extra condition because c is unsigned
-    for (c = n - 1; c >= i && c < n; c--) {
-	// copy element e_siz bytes at c to c + 1
-	memcpy((c + 1) * e_siz + ca, c * e_siz + ca, e_siz);
-    }
+    // shift elements i to n - 1 to the right by 1 in one move
+    memmove((i + 1) * e_siz + ca, i * e_siz + ca, (n - i) * e_siz);
+    da->b_moved += (n - i) * e_siz;
     // insert e_siz bytes from e at i
     memcpy(i * e_siz + ca, e, e_siz);
 }
@@ -431,17 +765,9 @@ void d_array__append(d_array *da, void *e) {
     // record size of element (da->e_siz)
     size_t e_siz;
     e_siz = da->e_siz;
-    // if da->siz == da->max_siz, double array size
+    // if da->siz == da->max_siz, grow according to the growth policy of da
     if (da->siz == da->max_siz) {
-	da->max_siz *= 2;
-	da->a = realloc(da->a, da->max_siz * e_siz);
-	// if da->a is NULL, print error and exit
-	if (da->a == NULL) {
-	    fprintf(stderr,
-		    "%s: realloc failure appending element at %p onto d_array at %p\n",
-		    D_ARRAY__APPEND_N, e, da);
-	    exit(2);
-	}
+	d_array__grow(da, da->siz + 1, D_ARRAY__APPEND_N);
     }
     // convert da->a to char *
     char *ca;
@@ -478,8 +804,8 @@ void d_array__remove(d_array *da, size_t i) {
 		"d_array at %p\n", D_ARRAY__REMOVE_N, da);
 	exit(1);
     }
-    // loop counter, size of element (da->e_siz)
-    size_t c, e_siz;
+    // size of element (da->e_siz)
+    size_t e_siz;
     // convert da->a to char *
     char *ca = (char *) da->a;
     // get size of element
@@ -488,31 +814,199 @@ void d_array__remove(d_array *da, size_t i) {
     if (*(da->t__ + strlen(da->t__) - 1) == '*') {
 	free(*((void **) ca + i));
     }
-    // for all elements c to da->siz - 2, copy the next element c + 1 to c
-    for (c = i; c < da->siz - 1; c++) {
-	memcpy(c * e_siz + ca, (c + 1) * e_siz + ca, e_siz);
-    }
+    // shift elements i + 1 to da->siz - 1 to the left by 1 in one move
+    memmove(i * e_siz + ca, (i + 1) * e_siz + ca, (da->siz - i - 1) * e_siz);
+    da->b_moved += (da->siz - i - 1) * e_siz;
     // decrement da->siz
     --da->siz;
-    // if da->siz <= da->max_siz / 4, halve array size
-    if (da->siz <= da->max_siz / 4) {
-	da->max_siz /= 2;
-	da->a = realloc(da->a, da->max_siz * e_siz);
-	// if da->a is NULL, print error and exit
-	if (da->a == NULL) {
-	    fprintf(stderr, "%s: realloc failure halving size of d_array at %p\n",
-		    D_ARRAY__APPEND_N, da);
-	    exit(2);
+    // shrink according to the growth policy of da (by default, halve array size if
+    // da->siz <= da->max_siz / 4)
+    d_array__shrink(da, D_ARRAY__REMOVE_N);
+}
+
+// for d_array da, appends n elements onto da, reading n * da->e_siz contiguous bytes
+// from e. da is resized at most once, so appending k elements costs one realloc
+// instead of up to log(k) of them. appending 0 elements does nothing.
+void d_array__append_n(d_array *da, void *e, size_t n) {
+    // if da is NULL, print error and exit
+    if (da == NULL) {
+	fprintf(stderr, "%s: cannot append elements onto null d_array\n",
+		D_ARRAY__APPEND_N_N);
+	exit(1);
+    }
+    // if n == 0, nothing to do
+    if (n == 0) {
+	return;
+    }
+    // if e is NULL, print error and exit
+    if (e == NULL) {
+	fprintf(stderr, "%s: cannot append null elements onto d_array at %p\n",
+		D_ARRAY__APPEND_N_N, da);
+	exit(1);
+    }
+    // record size of element (da->e_siz)
+    size_t e_siz;
+    e_siz = da->e_siz;
+    // if there is not enough room for n more elements, grow according to the growth
+    // policy of da until there is, and then realloc only once
+    d_array__grow(da, da->siz + n, D_ARRAY__APPEND_N_N);
+    // copy all n elements after the last element and update da->siz
+    memcpy((char *) da->a + da->siz * e_siz, e, n * e_siz);
+    da->siz += n;
+}
+
+// writes n * da->e_siz contiguous bytes from e into da starting at index i, effectively
+// inserting n new elements. i may be any index from 0 to da->siz (inserting at da->siz
+// is the same as d_array__append_n). the elements at i and after are shifted right by
+// n with a single memmove, so inserting k elements is O(da->siz + k) rather than
+// O(da->siz * k) as with repeated calls to d_array__insert.
+void d_array__insert_range(d_array *da, void *e, size_t n, size_t i) {
+    // if da is NULL, print error and exit
+    if (da == NULL) {
+	fprintf(stderr, "%s: cannot insert elements into null d_array\n",
+		D_ARRAY__INSERT_RANGE_N);
+	exit(1);
+    }
+    // if i > da->siz, print error and exit (unlike d_array__insert, i == da->siz is
+    // allowed, which appends the elements)
+    if (i > da->siz) {
+	fprintf(stderr,
+		"%s: cannot insert outside of defined array bounds of d_array at %p\n",
+		D_ARRAY__INSERT_RANGE_N, da);
+	exit(1);
+    }
+    // if n == 0, nothing to do
+    if (n == 0) {
+	return;
+    }
+    // if e is NULL, print error and exit
+    if (e == NULL) {
+	fprintf(stderr, "%s: cannot insert null elements into d_array at %p\n",
+		D_ARRAY__INSERT_RANGE_N, da);
+	exit(1);
+    }
+    // record size of element (da->e_siz)
+    size_t e_siz;
+    e_siz = da->e_siz;
+    // grow once to fit n more elements, same as in d_array__append_n
+    d_array__grow(da, da->siz + n, D_ARRAY__INSERT_RANGE_N);
+    // convert da->a to char *
+    char *ca = (char *) da->a;
+    // shift elements i to da->siz - 1 right by n in one move (regions overlap, so we
+    // must use memmove), then copy the new elements into the gap
+    memmove(ca + (i + n) * e_siz, ca + i * e_siz, (da->siz - i) * e_siz);
+    da->b_moved += (da->siz - i) * e_siz;
+    memcpy(ca + i * e_siz, e, n * e_siz);
+    da->siz += n;
+}
+
+// for d_array da, removes the elements from index si to ei - 1, where si <= ei <=
+// da->siz. the tail of the d_array is shifted left with a single memmove, and the
+// capacity of da is halved as many times as d_array__remove would have halved it, but
+// with at most one realloc. if the d_array is a pointer type, the memory pointed to by
+// each removed element will also be freed. can use ALL__(da) to clear da.
+void d_array__remove_range(d_array *da, size_t si, size_t ei) {
+    // if da is NULL, print error and exit
+    if (da == NULL) {
+	fprintf(stderr, "%s: cannot remove elements from null d_array\n",
+		D_ARRAY__REMOVE_RANGE_N);
+	exit(1);
+    }
+    // if si > ei or ei > da->siz, print error and exit
+    if (si > ei || ei > da->siz) {
+	fprintf(stderr, "%s: cannot remove elements from outside defined array bounds "
+		"of d_array at %p\n", D_ARRAY__REMOVE_RANGE_N, da);
+	exit(1);
+    }
+    // if the range is empty, nothing to do
+    if (si == ei) {
+	return;
+    }
+    // loop counter, size of element (da->e_siz)
+    size_t c, e_siz;
+    // convert da->a to char *
+    char *ca = (char *) da->a;
+    e_siz = da->e_siz;
+    // if da->t__ is a pointer type, free the underlying memory for each element
+    if (*(da->t__ + strlen(da->t__) - 1) == '*') {
+	for (c = si; c < ei; c++) {
+	    free(*((void **) ca + c));
 	}
     }
+    // shift elements ei to da->siz - 1 left by ei - si in one move
+    memmove(ca + si * e_siz, ca + ei * e_siz, (da->siz - ei) * e_siz);
+    da->b_moved += (da->siz - ei) * e_siz;
+    da->siz -= ei - si;
+    // shrink according to the growth policy of da, with at most one realloc
+    d_array__shrink(da, D_ARRAY__REMOVE_RANGE_N);
+}
+
+// makes sure that da can hold at least n elements without being resized, resizing da
+// to exactly n elements if it cannot. never reduces the capacity of da. note that a
+// later remove may still shrink da below n unless its policy never shrinks.
+void d_array__reserve(d_array *da, size_t n) {
+    // if da is NULL, print error and exit
+    if (da == NULL) {
+	fprintf(stderr, "%s: cannot reserve space in null d_array\n", D_ARRAY__RESERVE_N);
+	exit(1);
+    }
+    if (n > da->max_siz) {
+	d_array__resize(da, n, D_ARRAY__RESERVE_N);
+    }
+}
+
+// reduces the capacity of da to da->siz elements (or 1 if da is empty) with one realloc
+void d_array__shrink_to_fit(d_array *da) {
+    // if da is NULL, print error and exit
+    if (da == NULL) {
+	fprintf(stderr, "%s: cannot shrink null d_array\n", D_ARRAY__SHRINK_TO_FIT_N);
+	exit(1);
+    }
+    size_t n_max;
+    n_max = (da->siz > 0) ? da->siz : 1;
+    if (n_max != da->max_siz) {
+	d_array__resize(da, n_max, D_ARRAY__SHRINK_TO_FIT_N);
+    }
 }
 
-// returns a void * to the element in d_array da located at index i
-void *d_array__get(d_array *da, size_t i) {
+// sets the growth policy of da. when da is full, its capacity is multiplied by g_fac,
+// growing by at least g_min elements. when da->siz <= da->max_siz * s_thr after a
+// remove, its capacity is divided by g_fac (or reduced by g_min if that is more) until
+// that is no longer true; s_thr == 0 means da never shrinks. g_fac must be >= 1, g_fac
+// must be > 1 if g_min is 0, and s_thr must be >= 0 and < 1. for hysteresis, choose
+// s_thr < 1 / g_fac, so that one shrink never brings da right back to full. can pass
+// D_ARRAY__POLICY__DEFAULT or D_ARRAY__POLICY__NO_SHRINK instead of the last 3 args.
+void d_array__set_policy(d_array *da, double g_fac, size_t g_min, double s_thr) {
     // if da is NULL, print error and exit
     if (da == NULL) {
-	fprintf(stderr, "%s: cannot return void * to element %u of null d_array\n",
-		D_ARRAY__GET_N, i);
+	fprintf(stderr, "%s: cannot set policy of null d_array\n", D_ARRAY__SET_POLICY_N);
+	exit(1);
+    }
+    // if g_fac < 1, or g_fac == 1 and g_min == 0 (da could never grow), print error and
+    // exit. the negated form also catches g_fac == NaN
+    if (!(g_fac >= 1) || (g_fac == 1 && g_min == 0)) {
+	fprintf(stderr, "%s: growth factor must be > 1, or 1 with positive minimum "
+		"growth, for d_array at %p\n", D_ARRAY__SET_POLICY_N, da);
+	exit(1);
+    }
+    // if s_thr is not in [0, 1), print error and exit
+    if (!(s_thr >= 0 && s_thr < 1)) {
+	fprintf(stderr, "%s: shrink threshold must be in [0, 1) for d_array at %p\n",
+		D_ARRAY__SET_POLICY_N, da);
+	exit(1);
+    }
+    da->__pol.g_fac = g_fac;
+    da->__pol.g_min = g_min;
+    da->__pol.s_thr = s_thr;
+}
+
+// returns a void * to the element in d_array da located at index i. the name is in
+// parentheses so that the D_ARRAY__RELEASE macro of the same name does not replace it.
+void *(d_array__get)(d_array *da, size_t i) {
+    // if da is NULL, print error and exit
+    if (da == NULL) {
+	fprintf(stderr, "%s: cannot return void * to element %lu of null d_array\n",
+		D_ARRAY__GET_N, (unsigned long) i);
 	exit(1);
     }
     // if i > da->siz - 1, print error and exit (size_t is unsigned, so we do not have
@@ -530,9 +1024,600 @@ void *d_array__get(d_array *da, size_t i) {
     return (void *) (ca + i * da->e_siz);
 }
 
+// compares two size_t for qsort, used by d_array__remove_many
+static int d_array__cmp_idx(const void *a, const void *b) {
+    size_t x = *((const size_t *) a), y = *((const size_t *) b);
+    return (x > y) - (x < y);
+}
+
+// for d_array da, removes every element for which pred(element, ctx) returns nonzero,
+// in one stable pass: the kept elements keep their order and each run of kept elements
+// is moved once. pred receives a const void * to each element in order, along with the
+// unchanged ctx. if the d_array is a pointer type, the memory pointed to by each
+// removed element is freed. da is resized at most once. returns no. elements removed.
+size_t d_array__remove_if(d_array *da, int (*pred)(const void *, void *), void *ctx) {
+    // if da is NULL, print error and exit
+    if (da == NULL) {
+	fprintf(stderr, "%s: cannot remove elements from null d_array\n",
+		D_ARRAY__REMOVE_IF_N);
+	exit(1);
+    }
+    // if pred is NULL, print error and exit
+    if (pred == NULL) {
+	fprintf(stderr, "%s: cannot remove elements from d_array at %p with null "
+		"predicate\n", D_ARRAY__REMOVE_IF_N, da);
+	exit(1);
+    }
+    // read index, write index, start of current run of kept elements, size of element
+    size_t r, w, k_s, e_siz;
+    // whether da is a pointer type (checked once instead of once per element)
+    int is_ptr;
+    char *ca = (char *) da->a;
+    e_siz = da->e_siz;
+    is_ptr = (*(da->t__ + strlen(da->t__) - 1) == '*');
+    w = k_s = 0;
+    for (r = 0; r < da->siz; r++) {
+	// kept elements extend the current run
+	if (!pred(ca + r * e_siz, ctx)) {
+	    continue;
+	}
+	// element r is removed: move the run k_s to r - 1 down to w in one move
+	if (k_s != w && r > k_s) {
+	    memmove(ca + w * e_siz, ca + k_s * e_siz, (r - k_s) * e_siz);
+	    da->b_moved += (r - k_s) * e_siz;
+	}
+	w += r - k_s;
+	k_s = r + 1;
+	if (is_ptr) {
+	    free(*((void **) ca + r));
+	}
+    }
+    // move the last run of kept elements
+    if (k_s != w && da->siz > k_s) {
+	memmove(ca + w * e_siz, ca + k_s * e_siz, (da->siz - k_s) * e_siz);
+	da->b_moved += (da->siz - k_s) * e_siz;
+    }
+    w += da->siz - k_s;
+    // no. removed elements, then update da->siz and shrink once
+    r = da->siz - w;
+    da->siz = w;
+    if (r > 0) {
+	d_array__shrink(da, D_ARRAY__REMOVE_IF_N);
+    }
+    return r;
+}
+
+// for d_array da, removes the n elements whose indices are given in idx, in one stable
+// pass, the same way as d_array__remove_if. idx does not need to be sorted (it is
+// sorted in a copy if it is not), and repeated indices are only removed once. each
+// index must be less than da->siz. returns no. elements removed.
+size_t d_array__remove_many(d_array *da, const size_t *idx, size_t n) {
+    // if da is NULL, print error and exit
+    if (da == NULL) {
+	fprintf(stderr, "%s: cannot remove elements from null d_array\n",
+		D_ARRAY__REMOVE_MANY_N);
+	exit(1);
+    }
+    // if n == 0, nothing to do
+    if (n == 0) {
+	return 0;
+    }
+    // if idx is NULL, print error and exit
+    if (idx == NULL) {
+	fprintf(stderr, "%s: cannot remove null indices from d_array at %p\n",
+		D_ARRAY__REMOVE_MANY_N, da);
+	exit(1);
+    }
+    // loop counter, read index, write index, size of element, no. removed
+    size_t c, r, w, e_siz, n_r;
+    // sorted indices (idx itself if it is already sorted)
+    size_t *s_idx;
+    s_idx = (size_t *) idx;
+    for (c = 0; c < n; c++) {
+	// if any index is out of bounds, print error and exit
+	if (idx[c] >= da->siz) {
+	    fprintf(stderr, "%s: cannot remove element from outside defined array bounds "
+		    "of d_array at %p\n", D_ARRAY__REMOVE_MANY_N, da);
+	    exit(1);
+	}
+	// if idx is not sorted, sort a copy
+	if (c > 0 && idx[c] < idx[c - 1] && s_idx == idx) {
+	    s_idx = (size_t *) malloc(n * sizeof(size_t));
+	    if (s_idx == NULL) {
+		fprintf(stderr, "%s: malloc error when sorting indices for d_array at "
+			"%p\n", D_ARRAY__REMOVE_MANY_N, da);
+		exit(2);
+	    }
+	    memcpy(s_idx, idx, n * sizeof(size_t));
+	}
+    }
+    if (s_idx != idx) {
+	qsort(s_idx, n, sizeof(size_t), d_array__cmp_idx);
+    }
+    char *ca = (char *) da->a;
+    int is_ptr = (*(da->t__ + strlen(da->t__) - 1) == '*');
+    e_siz = da->e_siz;
+    // the kept run before each removed index s_idx[c] is r to s_idx[c] - 1
+    w = r = 0;
+    for (c = 0; c < n; c++) {
+	// skip repeated indices
+	if (c > 0 && s_idx[c] == s_idx[c - 1]) {
+	    continue;
+	}
+	if (w != r && s_idx[c] > r) {
+	    memmove(ca + w * e_siz, ca + r * e_siz, (s_idx[c] - r) * e_siz);
+	    da->b_moved += (s_idx[c] - r) * e_siz;
+	}
+	w += s_idx[c] - r;
+	r = s_idx[c] + 1;
+	if (is_ptr) {
+	    free(*((void **) ca + s_idx[c]));
+	}
+    }
+    // move the last kept run
+    if (w != r && da->siz > r) {
+	memmove(ca + w * e_siz, ca + r * e_siz, (da->siz - r) * e_siz);
+	da->b_moved += (da->siz - r) * e_siz;
+    }
+    w += da->siz - r;
+    if (s_idx != idx) {
+	free(s_idx);
+    }
+    n_r = da->siz - w;
+    da->siz = w;
+    d_array__shrink(da, D_ARRAY__REMOVE_MANY_N);
+    return n_r;
+}
+
+/* sorting and searching. the default numeric types (int, long, double) are sorted
+   without a comparator by mapping each element in place to an unsigned integer key of
+   the same width whose unsigned order is the numeric order, LSD radix sorting the keys
+   a byte at a time, and mapping the keys back. */
+
+// kinds of d_array elements that can be sorted and searched without a comparator
+#define D_ARRAY__NUM_NONE 0
+#define D_ARRAY__NUM_INT 1
+#define D_ARRAY__NUM_DOUBLE 2
+// below this many elements, keys are insertion sorted instead of radix sorted
+#define D_ARRAY__RADIX_MIN 64
+
+// returns the kind of the elements of da: D_ARRAY__NUM_INT for 4 or 8 byte int and long,
+// D_ARRAY__NUM_DOUBLE for 8 byte double, else D_ARRAY__NUM_NONE
+static int d_array__num_kind(d_array *da) {
+    if ((da->e_siz == 4 || da->e_siz == 8) &&
+	(strcmp(da->t__, __DATYPE__INT) == 0 || strcmp(da->t__, __DATYPE__LONG) == 0)) {
+	return D_ARRAY__NUM_INT;
+    }
+    if (da->e_siz == 8 && strcmp(da->t__, __DATYPE__DOUBLE) == 0) {
+	return D_ARRAY__NUM_DOUBLE;
+    }
+    return D_ARRAY__NUM_NONE;
+}
+
+// maps the signed integer or double with bits b to its key, and back. flipping the sign
+// bit puts negative integers below positive ones; for doubles, negative values also
+// have all their other bits flipped, since their magnitude grows with their bits. this
+// puts -NaN before -inf and NaN after inf, and -0 right before 0.
+static uint32_t d_array__key32(uint32_t b) {
+    return b ^ 0x80000000u;
+}
+static uint64_t d_array__key64(uint64_t b, int kind) {
+    if (kind == D_ARRAY__NUM_DOUBLE && (b >> 63) != 0) {
+	return ~b;
+    }
+    return b ^ (((uint64_t) 1) << 63);
+}
+static uint64_t d_array__unkey64(uint64_t k, int kind) {
+    if (kind == D_ARRAY__NUM_DOUBLE && (k >> 63) == 0) {
+	return ~k;
+    }
+    return k ^ (((uint64_t) 1) << 63);
+}
+
+// maps the n elements at a of width e_siz to keys in place (to_k != 0) or back
+static void d_array__map_keys(void *a, size_t n, size_t e_siz, int kind, int to_k) {
+    size_t i;
+    if (e_siz == 4) {
+	uint32_t *k = (uint32_t *) a;
+	// flipping the sign bit is its own inverse
+	for (i = 0; i < n; i++) {
+	    k[i] = d_array__key32(k[i]);
+	}
+	return;
+    }
+    uint64_t *k = (uint64_t *) a;
+    if (to_k) {
+	for (i = 0; i < n; i++) {
+	    k[i] = d_array__key64(k[i], kind);
+	}
+    }
+    else {
+	for (i = 0; i < n; i++) {
+	    k[i] = d_array__unkey64(k[i], kind);
+	}
+    }
+}
+
+// LSD radix sorts the n keys at a, using the n keys of space at t, one byte per pass.
+// the counts for all passes are taken in one read of a, and passes where every key has
+// the same byte are skipped. the sorted keys end up in a.
+#define D_ARRAY__RADIX_DEF(W, T) \
+    static void d_array__radix##W(T *a, T *t, size_t n) { \
+	size_t c[W / 8][256], i, o, s; \
+	unsigned p; \
+	T *src = a, *dst = t, *tmp; \
+	if (n < D_ARRAY__RADIX_MIN) { \
+	    T x; \
+	    size_t j; \
+	    for (i = 1; i < n; i++) { \
+		x = a[i]; \
+		for (j = i; j > 0 && a[j - 1] > x; j--) { \
+		    a[j] = a[j - 1]; \
+		} \
+		a[j] = x; \
+	    } \
+	    return; \
+	} \
+	memset(c, 0, sizeof(c)); \
+	for (i = 0; i < n; i++) { \
+	    for (p = 0; p < W / 8; p++) { \
+		c[p][(a[i] >> (8 * p)) & 0xFF]++; \
+	    } \
+	} \
+	for (p = 0; p < W / 8; p++) { \
+	    if (c[p][(a[0] >> (8 * p)) & 0xFF] == n) { \
+		continue; \
+	    } \
+	    /* turn the counts into the index of the first key with each byte */ \
+	    for (o = 0, i = 0; i < 256; i++) { \
+		s = c[p][i]; \
+		c[p][i] = o; \
+		o += s; \
+	    } \
+	    for (i = 0; i < n; i++) { \
+		dst[c[p][(src[i] >> (8 * p)) & 0xFF]++] = src[i]; \
+	    } \
+	    tmp = src; \
+	    src = dst; \
+	    dst = tmp; \
+	} \
+	if (src != a) { \
+	    memcpy(a, src, n * sizeof(T)); \
+	} \
+    }
+D_ARRAY__RADIX_DEF(32, uint32_t)
+D_ARRAY__RADIX_DEF(64, uint64_t)
+#undef D_ARRAY__RADIX_DEF
+
+// sorts the n elements at a of width e_siz and the given kind (not D_ARRAY__NUM_NONE)
+// with the n elements of space at t, leaving them mapped to keys
+static void d_array__radix_keys(void *a, void *t, size_t n, size_t e_siz, int kind) {
+    d_array__map_keys(a, n, e_siz, kind, 1);
+    if (e_siz == 4) {
+	d_array__radix32((uint32_t *) a, (uint32_t *) t, n);
+    }
+    else {
+	d_array__radix64((uint64_t *) a, (uint64_t *) t, n);
+    }
+}
+
+// returns kind of da if da can be sorted or searched without a comparator, else prints
+// an error for the function fn and exits
+static int d_array__sort_kind(d_array *da, const char *fn) {
+    int kind = d_array__num_kind(da);
+    if (kind == D_ARRAY__NUM_NONE) {
+	fprintf(stderr, "%s: d_array at %p of type %s needs a comparator\n", fn, da,
+		da->t__);
+	exit(1);
+    }
+    return kind;
+}
+
+// sorts da in ascending order. if cmp is NULL, da must be one of the default types
+// int, long, or double, which are LSD radix sorted: O(da->siz) and stable, with no
+// function call per comparison. doubles are sorted by value with -0 before 0 and NaNs
+// at the ends (NaNs with the sign bit set first, the others last). else elements are
+// sorted with qsort and cmp, which is called like the comparator of qsort and need not
+// be stable. the radix sort takes da->siz elements of scratch memory from the
+// allocator of da.
+void d_array__sort(d_array *da, int (*cmp)(const void *, const void *)) {
+    // if da is NULL, print error and exit
+    if (da == NULL) {
+	fprintf(stderr, "%s: cannot sort null d_array\n", D_ARRAY__SORT_N);
+	exit(1);
+    }
+    if (cmp != NULL) {
+	qsort(da->a, da->siz, da->e_siz, cmp);
+	return;
+    }
+    int kind = d_array__sort_kind(da, D_ARRAY__SORT_N);
+    void *t = NULL;
+    // small arrays are insertion sorted in place and need no scratch memory
+    if (da->siz >= D_ARRAY__RADIX_MIN) {
+	t = da->__al->alloc_f(da->__al->ctx, da->siz * da->e_siz);
+	// if t is NULL, print error and exit
+	if (t == NULL) {
+	    fprintf(stderr, "%s: malloc error when allocating scratch memory for d_array "
+		    "at %p\n", D_ARRAY__SORT_N, da);
+	    exit(2);
+	}
+    }
+    d_array__radix_keys(da->a, t, da->siz, da->e_siz, kind);
+    d_array__map_keys(da->a, da->siz, da->e_siz, kind, 0);
+    if (t != NULL) {
+	da->__al->free_f(da->__al->ctx, t, da->siz * da->e_siz);
+    }
+}
+
+// work for one thread of d_array__sort_mt: sorts the run a[0 .. n_l - 1] (with scratch
+// at t) if n_r == 0, else merges the sorted runs a[0 .. n_l - 1] and a[n_l .. n_l + n_r
+// - 1] into t. keys (kind != D_ARRAY__NUM_NONE) are compared as unsigned integers,
+// other elements with cmp.
+struct d_array__sort_job {
+    char *a, *t;
+    size_t n_l, n_r, e_siz;
+    int kind;
+    int (*cmp)(const void *, const void *);
+};
+
+// merges the sorted runs l[0 .. n_l - 1] and r[0 .. n_r - 1] of keys into d, taking
+// from l on ties so that the merge is stable
+#define D_ARRAY__MERGE_DEF(W, T) \
+    static void d_array__merge##W(const T *l, size_t n_l, const T *r, size_t n_r, \
+				  T *d) { \
+	size_t i = 0, j = 0, k = 0; \
+	while (i < n_l && j < n_r) { \
+	    d[k++] = (r[j] < l[i]) ? r[j++] : l[i++]; \
+	} \
+	memcpy(d + k, l + i, (n_l - i) * sizeof(T)); \
+	memcpy(d + k + n_l - i, r + j, (n_r - j) * sizeof(T)); \
+    }
+D_ARRAY__MERGE_DEF(32, uint32_t)
+D_ARRAY__MERGE_DEF(64, uint64_t)
+#undef D_ARRAY__MERGE_DEF
+
+// runs one struct d_array__sort_job; the argument and return value are for pthreads
+static void *d_array__sort_job_f(void *arg) {
+    struct d_array__sort_job *j = (struct d_array__sort_job *) arg;
+    size_t i, k, e_siz = j->e_siz;
+    char *l, *r;
+    if (j->n_r == 0) {
+	if (j->kind != D_ARRAY__NUM_NONE) {
+	    d_array__radix_keys(j->a, j->t, j->n_l, e_siz, j->kind);
+	}
+	else {
+	    qsort(j->a, j->n_l, e_siz, j->cmp);
+	}
+	return NULL;
+    }
+    l = j->a;
+    r = j->a + j->n_l * e_siz;
+    if (j->kind != D_ARRAY__NUM_NONE && e_siz == 4) {
+	d_array__merge32((uint32_t *) l, j->n_l, (uint32_t *) r, j->n_r, (uint32_t *) j->t);
+	return NULL;
+    }
+    if (j->kind != D_ARRAY__NUM_NONE) {
+	d_array__merge64((uint64_t *) l, j->n_l, (uint64_t *) r, j->n_r, (uint64_t *) j->t);
+	return NULL;
+    }
+    // generic merge, copying one element at a time
+    i = k = 0;
+    size_t m = 0;
+    while (i < j->n_l && k < j->n_r) {
+	if (j->cmp(r + k * e_siz, l + i * e_siz) < 0) {
+	    memcpy(j->t + m * e_siz, r + k * e_siz, e_siz);
+	    k++;
+	}
+	else {
+	    memcpy(j->t + m * e_siz, l + i * e_siz, e_siz);
+	    i++;
+	}
+	m++;
+    }
+    memcpy(j->t + m * e_siz, l + i * e_siz, (j->n_l - i) * e_siz);
+    memcpy(j->t + (m + j->n_l - i) * e_siz, r + k * e_siz, (j->n_r - k) * e_siz);
+    return NULL;
+}
+
+// runs the n_j jobs in j, each on its own thread th[i], and waits for them. a job whose
+// thread cannot be created is run on the calling thread instead; ok[i] records which.
+static void d_array__sort_run(struct d_array__sort_job *j, pthread_t *th, char *ok,
+			      size_t n_j) {
+    size_t i;
+    for (i = 0; i < n_j; i++) {
+	ok[i] = (pthread_create(th + i, NULL, d_array__sort_job_f, j + i) == 0);
+	if (!ok[i]) {
+	    d_array__sort_job_f(j + i);
+	}
+    }
+    for (i = 0; i < n_j; i++) {
+	if (ok[i]) {
+	    pthread_join(th[i], NULL);
+	}
+    }
+}
+
+// same as d_array__sort, but splits da into up to n_thr runs that are sorted on their
+// own threads, then merges pairs of runs on their own threads until one run is left.
+// each thread gets at least D_ARRAY__SORT_MT_MIN elements, and with n_thr <= 1 (or a
+// small da) this is simply d_array__sort. the result is the same as that of
+// d_array__sort, except that with cmp it is a merge of qsort runs (so equal elements
+// of different runs keep their order). takes da->siz elements of scratch memory from
+// the allocator of da.
+void d_array__sort_mt(d_array *da, int (*cmp)(const void *, const void *), int n_thr) {
+    // if da is NULL, print error and exit
+    if (da == NULL) {
+	fprintf(stderr, "%s: cannot sort null d_array\n", D_ARRAY__SORT_MT_N);
+	exit(1);
+    }
+    int kind = D_ARRAY__NUM_NONE;
+    if (cmp == NULL) {
+	kind = d_array__sort_kind(da, D_ARRAY__SORT_MT_N);
+    }
+    // no. runs, elements per run, loop counters, width of runs in the current round
+    size_t n_run, r_siz, i, n_j, w, e_siz;
+    n_run = (n_thr > 1) ? (size_t) n_thr : 1;
+    if (n_run > da->siz / D_ARRAY__SORT_MT_MIN) {
+	n_run = da->siz / D_ARRAY__SORT_MT_MIN;
+    }
+    if (n_run <= 1) {
+	d_array__sort(da, cmp);
+	return;
+    }
+    e_siz = da->e_siz;
+    r_siz = (da->siz + n_run - 1) / n_run;
+    char *a, *t, *src, *dst, *tmp, *ok;
+    struct d_array__sort_job *j;
+    pthread_t *th;
+    a = (char *) da->a;
+    t = (char *) da->__al->alloc_f(da->__al->ctx, da->siz * e_siz);
+    j = (struct d_array__sort_job *) malloc(n_run * sizeof(struct d_array__sort_job));
+    th = (pthread_t *) malloc(n_run * sizeof(pthread_t));
+    ok = (char *) malloc(n_run);
+    // if any is NULL, print error and exit
+    if (t == NULL || j == NULL || th == NULL || ok == NULL) {
+	fprintf(stderr, "%s: malloc error when allocating scratch memory for d_array at "
+		"%p\n", D_ARRAY__SORT_MT_N, da);
+	exit(2);
+    }
+    // sort each run, in place
+    for (i = 0; i < n_run; i++) {
+	j[i].a = a + i * r_siz * e_siz;
+	j[i].t = t + i * r_siz * e_siz;
+	j[i].n_l = (i < n_run - 1) ? r_siz : da->siz - i * r_siz;
+	j[i].n_r = 0;
+	j[i].e_siz = e_siz;
+	j[i].kind = kind;
+	j[i].cmp = cmp;
+    }
+    d_array__sort_run(j, th, ok, n_run);
+    // merge pairs of runs of w elements from src into dst, then swap src and dst
+    src = a;
+    dst = t;
+    for (w = r_siz; w < da->siz; w = 2 * w) {
+	n_j = 0;
+	for (i = 0; i < da->siz; i += 2 * w) {
+	    j[n_j].a = src + i * e_siz;
+	    j[n_j].t = dst + i * e_siz;
+	    j[n_j].n_l = (da->siz - i < w) ? da->siz - i : w;
+	    j[n_j].n_r = (da->siz - i < 2 * w) ? da->siz - i - j[n_j].n_l : w;
+	    // a run without a partner is copied over
+	    if (j[n_j].n_r == 0) {
+		memcpy(j[n_j].t, j[n_j].a, j[n_j].n_l * e_siz);
+		continue;
+	    }
+	    n_j++;
+	}
+	d_array__sort_run(j, th, ok, n_j);
+	tmp = src;
+	src = dst;
+	dst = tmp;
+    }
+    if (src != a) {
+	memcpy(a, src, da->siz * e_siz);
+    }
+    if (kind != D_ARRAY__NUM_NONE) {
+	d_array__map_keys(a, da->siz, e_siz, kind, 0);
+    }
+    da->__al->free_f(da->__al->ctx, t, da->siz * e_siz);
+    free(j);
+    free(th);
+    free(ok);
+}
+
+// returns the index of the first element of the sorted da that is not less than the
+// element at key, or da->siz if there is none, with O(log(da->siz)) comparisons. cmp is
+// the comparator da was sorted with; if cmp is NULL, da must be one of the default
+// types int, long, or double and sorted by d_array__sort without a comparator, and
+// elements are compared directly, in the same order as d_array__sort.
+size_t d_array__lower_bound(d_array *da, const void *key,
+			    int (*cmp)(const void *, const void *)) {
+    // if da or key is NULL, print error and exit
+    if (da == NULL || key == NULL) {
+	fprintf(stderr, "%s: cannot search null d_array or for null key\n",
+		D_ARRAY__LOWER_BOUND_N);
+	exit(1);
+    }
+    // start of the range that may hold the answer, no. elements in the range, half
+    size_t lo, n, h;
+    lo = 0;
+    n = da->siz;
+    if (cmp != NULL) {
+	char *ca = (char *) da->a;
+	while (n > 0) {
+	    h = n / 2;
+	    if (cmp(ca + (lo + h) * da->e_siz, key) < 0) {
+		lo = lo + h + 1;
+		n = n - h - 1;
+	    }
+	    else {
+		n = h;
+	    }
+	}
+	return lo;
+    }
+    int kind = d_array__sort_kind(da, D_ARRAY__LOWER_BOUND_N);
+    if (da->e_siz == 4) {
+	const uint32_t *a = (const uint32_t *) da->a;
+	uint32_t k = d_array__key32(*((const uint32_t *) key));
+	while (n > 0) {
+	    h = n / 2;
+	    if (d_array__key32(a[lo + h]) < k) {
+		lo = lo + h + 1;
+		n = n - h - 1;
+	    }
+	    else {
+		n = h;
+	    }
+	}
+	return lo;
+    }
+    const uint64_t *a = (const uint64_t *) da->a;
+    uint64_t k;
+    memcpy(&k, key, sizeof(k));
+    k = d_array__key64(k, kind);
+    while (n > 0) {
+	h = n / 2;
+	if (d_array__key64(a[lo + h], kind) < k) {
+	    lo = lo + h + 1;
+	    n = n - h - 1;
+	}
+	else {
+	    n = h;
+	}
+    }
+    return lo;
+}
+
+// returns a void * to an element of the sorted da that is equal to the element at key,
+// or NULL if there is none. cmp is the same as for d_array__lower_bound; if there are
+// several equal elements, the first one is returned.
+void *d_array__bsearch(d_array *da, const void *key,
+		       int (*cmp)(const void *, const void *)) {
+    // if da or key is NULL, print error and exit
+    if (da == NULL || key == NULL) {
+	fprintf(stderr, "%s: cannot search null d_array or for null key\n",
+		D_ARRAY__BSEARCH_N);
+	exit(1);
+    }
+    size_t i;
+    char *e;
+    i = d_array__lower_bound(da, key, cmp);
+    if (i == da->siz) {
+	return NULL;
+    }
+    e = (char *) da->a + i * da->e_siz;
+    // with cmp, equal means neither is less; else the bits must match (so -0 and 0 are
+    // different doubles, as they are for d_array__sort)
+    if (cmp != NULL) {
+	return (cmp(e, key) == 0) ? (void *) e : NULL;
+    }
+    return (memcmp(e, key, da->e_siz) == 0) ? (void *) e : NULL;
+}
+
 // for an element located at address p, for d_array da, the ith element of da will be
-// written directly to the address at p.
-void d_array__getcpy(void *p, d_array *da, size_t i) {
+// written directly to the address at p. the name is in parentheses like d_array__get.
+void (d_array__getcpy)(void *p, d_array *da, size_t i) {
     // if p is NULL, print error and exit
     if (p == NULL) {
 	fprintf(stderr, "%s: cannot write to null address from d_array at %p\n",
@@ -561,8 +1646,8 @@ void d_array__getcpy(void *p, d_array *da, size_t i) {
 }
 
 // for an element located at address p, for the d_array da, da->e_siz bytes from p will
-// overwrite the ith element in da.
-void d_array__set(d_array *da, size_t i, void *p) {
+// overwrite the ith element in da. the name is in parentheses like d_array__get.
+void (d_array__set)(d_array *da, size_t i, void *p) {
     // if da is NULL, print error and exit
     if (da == NULL) {
 	fprintf(stderr, "%s: cannot write from address %p to null d_array\n",
@@ -606,7 +1691,7 @@ void d_array__free(d_array *da) {
 	    free(*((void **) da->a + i++));
 	}
     }
-    // free da->a and da
-    free(da->a);
-    free(da);
+    // free da->a and da through the allocator of da
+    da->__al->free_f(da->__al->ctx, da->a, da->max_siz * da->e_siz);
+    da->__al->free_f(da->__al->ctx, da, sizeof(d_array));
 }
@@ -15,6 +15,26 @@
  *
  * Changelog:
  *
+ * 10-17-2026
+ *
+ * added declarations and function name macros for the bulk range functions
+ * d_array__append_n, d_array__insert_range, and d_array__remove_range. added the
+ * allocator member __al to the d_array struct and d_array__new_with_alloc. added the
+ * d_array_policy struct, the growth policy member __pol and the counters n_realloc and
+ * b_moved to the d_array struct, the D_ARRAY__POLICY__* macros, and declarations for
+ * d_array__reserve, d_array__shrink_to_fit, and d_array__set_policy. added
+ * declarations for d_array__remove_if and d_array__remove_many. added the d_writer and
+ * d_wbuf structs, the __wrstr_el member of the d_array struct, the __wrstr_el__*
+ * functions, and declarations for d_writer__file, d_writer__buf, d_array__write, and
+ * d_array__set_wrstr_el. __tostr_el__long and __tostr_el__double no longer return
+ * NULL, so D_ARRAY__LONG and D_ARRAY__DOUBLE d_arrays can be printed. added
+ * declarations for d_array__sort, d_array__sort_mt, d_array__lower_bound, and
+ * d_array__bsearch. added the unchecked inline accessors d_array__get_u,
+ * d_array__getcpy_u, and d_array__set_u, the iterator functions d_array__begin,
+ * d_array__end, and d_array__next with the D_ARRAY__FOREACH macro, and the
+ * D_ARRAY__RELEASE switch, which replaces d_array__get, d_array__getcpy, and
+ * d_array__set with inline versions that only assert their arguments.
+ *
  * 12-02-2018
  *
  * changed line spacings to make everything more readable on a smaller buffer (we want
@@ -74,12 +94,20 @@
 #define D_ARRAY_H
 // include stddef.h for size_t
 #include <stddef.h>
+// for memcpy in the inline accessors, and assert in their D_ARRAY__RELEASE versions
+#include <string.h>
+#include <assert.h>
+// for FILE, used by d_writer__file
+#include <stdio.h>
+// allocator interface for d_array__new_with_alloc
+#include "d_alloc.h"
 // automatic starting size (emulating Java's ArrayList) of 1
 #define AUTO_SIZ 1
 // default no. starting elements in dynamic array
 #define DEFAULT_SIZ 10
 // user function names
 #define D_ARRAY__NEW_N "d_array__new"
+#define D_ARRAY__NEW_WITH_ALLOC_N "d_array__new_with_alloc"
 #define D_ARRAY__FREE_N "d_array__free"
 #define D_ARRAY__INSERT_N "d_array__insert"
 #define D_ARRAY__APPEND_N "d_array__append"
@@ -88,6 +116,49 @@
 #define D_ARRAY__GETCPY_N "d_array__getcpy"
 #define D_ARRAY__SET_N "d_array__set"
 #define D_ARRAY__TOSTR_N "d_array__tostr"
+#define D_ARRAY__APPEND_N_N "d_array__append_n"
+#define D_ARRAY__INSERT_RANGE_N "d_array__insert_range"
+#define D_ARRAY__REMOVE_RANGE_N "d_array__remove_range"
+#define D_ARRAY__RESERVE_N "d_array__reserve"
+#define D_ARRAY__SHRINK_TO_FIT_N "d_array__shrink_to_fit"
+#define D_ARRAY__SET_POLICY_N "d_array__set_policy"
+#define D_ARRAY__REMOVE_IF_N "d_array__remove_if"
+#define D_ARRAY__REMOVE_MANY_N "d_array__remove_many"
+#define D_ARRAY__WRITE_N "d_array__write"
+#define D_ARRAY__SET_WRSTR_EL_N "d_array__set_wrstr_el"
+#define D_ARRAY__SORT_N "d_array__sort"
+#define D_ARRAY__SORT_MT_N "d_array__sort_mt"
+#define D_ARRAY__LOWER_BOUND_N "d_array__lower_bound"
+#define D_ARRAY__BSEARCH_N "d_array__bsearch"
+// d_array__sort_mt gives each thread at least this many elements
+#define D_ARRAY__SORT_MT_MIN 16384
+// growth policy of a d_array; see d_array__set_policy
+struct d_array_policy {
+    // factor capacity is multiplied by when growing and divided by when shrinking
+    double g_fac;
+    // minimum no. elements capacity changes by when growing or shrinking
+    size_t g_min;
+    // capacity shrinks when no. elements <= capacity * s_thr; 0 to never shrink
+    double s_thr;
+};
+typedef struct d_array_policy d_array_policy;
+// output interface for d_array__write
+struct d_writer {
+    // writes the n chars at s (not null-terminated), returning the no. chars written;
+    // anything less than n is treated as an error
+    size_t (*write_f)(void *ctx, const char *s, size_t n);
+    // context passed to write_f
+    void *ctx;
+};
+typedef struct d_writer d_writer;
+// caller-owned buffer written to by a d_writer from d_writer__buf
+struct d_wbuf {
+    // buffer, no. chars in buffer (including null-terminating char), no. chars written
+    // (including those that did not fit)
+    char *s;
+    size_t max, len;
+};
+typedef struct d_wbuf d_wbuf;
 // struct for dynamic array
 struct d_array {
     // point to an element (to serve as an array)
@@ -113,6 +184,17 @@ struct d_array {
     char *t__;
     // char element separator, char printed before elements, char printed after elements
     char __sep, __pr_c, __ps_c;
+    // allocator used for the d_array struct and a (&d_alloc__std unless the d_array was
+    // created with d_array__new_with_alloc)
+    const d_alloc *__al;
+    // growth policy (set with d_array__set_policy)
+    d_array_policy __pol;
+    // no. times a has been resized, no. bytes of elements moved, either shifted by
+    // inserts and removes or copied because a moved when it was resized
+    size_t n_realloc, b_moved;
+    // writes an element into a buffer without allocating; see d_array__set_wrstr_el.
+    // NULL unless set, in which case the default types use their __wrstr_el__* function
+    size_t (*__wrstr_el)(char *, size_t, const void *);
 };
 typedef struct d_array d_array;
 // string literals for type declarations
@@ -134,6 +216,14 @@ char *__tostr_el__double(const void *e);
 #define __TOSTR_EL__CHAR__PTR_N "__tostr_el__char__ptr"
 #define __TOSTR_EL__LONG_N "__tostr_el__long"
 #define __TOSTR_EL__DOUBLE_N "__tostr_el__double"
+// functions that write the element at e into the buffer s of n chars, without a
+// null-terminating char, and return its length as a string. nothing is written if the
+// length is greater than n. used by d_array__write for the default types.
+size_t __wrstr_el__int(char *s, size_t n, const void *e);
+size_t __wrstr_el__char(char *s, size_t n, const void *e);
+size_t __wrstr_el__char__ptr(char *s, size_t n, const void *e);
+size_t __wrstr_el__long(char *s, size_t n, const void *e);
+size_t __wrstr_el__double(char *s, size_t n, const void *e);
 // macros for defining d_array type, appropriate pointer to bind to __tostr_el, and
 // correct format for separators and pre- + post- char
 #define D_ARRAY__INT sizeof(int), __tostr_el__int, __DATYPE__INT, ' ', '[', ']'
@@ -143,6 +233,12 @@ char *__tostr_el__double(const void *e);
 #define D_ARRAY__LONG sizeof(long), __tostr_el__long, __DATYPE__LONG, ' ', '[', ']'
 #define D_ARRAY__DOUBLE sizeof(double), __tostr_el__double, __DATYPE__DOUBLE, ' ', '[', ']'
 #define D_ARRAY__VOID__PTR sizeof(void *), NULL, __DATYPE__VOID__PTR, '\0', '\0', '\0'
+// macros for the growth policy arguments of d_array__set_policy. the default policy,
+// which new d_arrays and d_array__view views start with, doubles capacity when full
+// and halves it when no more than a quarter full; the no-shrink policy is the same
+// but never gives memory back.
+#define D_ARRAY__POLICY__DEFAULT 2.0, 1, 0.25
+#define D_ARRAY__POLICY__NO_SHRINK 2.0, 1, 0.0
 // macro to replace all 3 arguments of d_array__tostr so that all elements in the array
 // will be written into the string that d_array__tostr will return a char * to
 #define ALL__(_DA) _DA, 0, _DA->siz
@@ -154,6 +250,28 @@ char *__tostr_el__double(const void *e);
 // recommended to use a sep/pp format specifying a macro for both default and user-defined
 // types. ex. d_array__tostr(da, 0, da->siz) -> d_array__tostr(ALL__(da))
 char *d_array__tostr(d_array *da, size_t si, size_t ei);
+// returns a d_writer that writes to the stream f with fwrite
+d_writer d_writer__file(FILE *f);
+// sets up wb to write into the caller's buffer s of max chars, and returns a d_writer
+// that writes into it. like snprintf, output that does not fit is cut off, s is always
+// null-terminated (if max > 0), and wb->len counts every char written, so the output
+// was cut off if wb->len >= max.
+d_writer d_writer__buf(d_wbuf *wb, char *s, size_t max);
+// given a d_array * da, size_t si and ei, writes elements si to ei - 1 in string form
+// to the writer w, in the same format as d_array__tostr. elements are formatted into a
+// stack buffer by da's __wrstr_el function (see d_array__set_wrstr_el), which for the
+// default types is picked automatically, and the buffer is handed to w whenever it
+// fills up, so there is no malloc per element. if da has no __wrstr_el function, its
+// __tostr_el function is used instead, and each string it returns is freed. can use
+// ALL__(da) for si and ei. returns 0 on success, -1 if w did not accept all chars.
+int d_array__write(d_array *da, size_t si, size_t ei, const d_writer *w);
+// sets the function d_array__write and d_array__tostr use to format an element of da
+// into a buffer. __wef(s, n, e) must write the element at e into s, which has room for
+// n chars, without a null-terminating character, and return the length of the element
+// as a string, writing nothing if that is greater than n. the default types get one
+// automatically; for user-defined types, setting one avoids the malloc and free per
+// element that __tostr_el requires. pass NULL to go back to using __tostr_el.
+void d_array__set_wrstr_el(d_array *da, size_t (*__wef)(char *, size_t, const void *));
 // creates a new d_array; if DEFAULT_SIZ is given then number of elements before resize
 // is 10 by default, while with AUTO_SIZ the number will be 1, similar to Java's ArrayList.
 // n is the no. elements that can be added before a resize is needed, e is the size of each
@@ -171,6 +289,13 @@ char *d_array__tostr(d_array *da, size_t si, size_t ei);
 // it is recommended that user-defined __tef and sep/pp be combined into a macro
 d_array *d_array__new(size_t n, size_t e, char *(*__tef)(const void *), const char *__t,
 		      char __sep, char __pr_c, char __ps_c);
+// same as d_array__new, except that the d_array struct and all the memory for its
+// elements come from the allocator al instead of from malloc. al must stay valid for as
+// long as the d_array is in use. ex. with a d_arena *ar from d_alloc.h,
+// d_array__new_with_alloc(DEFAULT_SIZ, D_ARRAY__INT, d_arena__al(ar))
+d_array *d_array__new_with_alloc(size_t n, size_t e, char *(*__tef)(const void *),
+				 const char *__t, char __sep, char __pr_c, char __ps_c,
+				 const d_alloc *al);
 // writes da->e_siz bytes from e into the d_array struct at index i, effectively inserting
 // a new element into da. one cannot insert to an index less than 0 or greater than
 // da->siz - 1, or insert NULL. please do not try and mix types, for your own sanity.
@@ -184,6 +309,75 @@ void d_array__append(d_array *da, void *e);
 // zero the former last element of the d_array upon removal of an element. if the d_array
 // is a pointer type, then the memory pointed to by the pointer will also be removed.
 void d_array__remove(d_array *da, size_t i);
+// for d_array da, appends n elements onto da, reading n * da->e_siz contiguous bytes
+// from e. da is resized at most once, so appending k elements costs one realloc
+// instead of up to log(k) of them. appending 0 elements does nothing.
+void d_array__append_n(d_array *da, void *e, size_t n);
+// writes n * da->e_siz contiguous bytes from e into da starting at index i, effectively
+// inserting n new elements. i may be any index from 0 to da->siz (inserting at da->siz
+// is the same as d_array__append_n). the elements at i and after are shifted right by
+// n with a single memmove, so inserting k elements is O(da->siz + k) rather than
+// O(da->siz * k) as with repeated calls to d_array__insert.
+void d_array__insert_range(d_array *da, void *e, size_t n, size_t i);
+// for d_array da, removes the elements from index si to ei - 1, where si <= ei <=
+// da->siz. the tail of the d_array is shifted left with a single memmove, and the
+// capacity of da is halved as many times as d_array__remove would have halved it, but
+// with at most one realloc. if the d_array is a pointer type, the memory pointed to by
+// each removed element will also be freed. can use ALL__(da) to clear da.
+void d_array__remove_range(d_array *da, size_t si, size_t ei);
+// makes sure that da can hold at least n elements without being resized, resizing da
+// to exactly n elements if it cannot. never reduces the capacity of da. note that a
+// later remove may still shrink da below n unless its policy never shrinks.
+void d_array__reserve(d_array *da, size_t n);
+// reduces the capacity of da to da->siz elements (or 1 if da is empty) with one realloc
+void d_array__shrink_to_fit(d_array *da);
+// sets the growth policy of da. when da is full, its capacity is multiplied by g_fac,
+// growing by at least g_min elements. when da->siz <= da->max_siz * s_thr after a
+// remove, its capacity is divided by g_fac (or reduced by g_min if that is more) until
+// that is no longer true; s_thr == 0 means da never shrinks. g_fac must be >= 1, g_fac
+// must be > 1 if g_min is 0, and s_thr must be >= 0 and < 1. for hysteresis, choose
+// s_thr < 1 / g_fac, so that one shrink never brings da right back to full. can pass
+// D_ARRAY__POLICY__DEFAULT or D_ARRAY__POLICY__NO_SHRINK instead of the last 3 args.
+void d_array__set_policy(d_array *da, double g_fac, size_t g_min, double s_thr);
+// for d_array da, removes every element for which pred(element, ctx) returns nonzero,
+// in one stable pass: the kept elements keep their order and each run of kept elements
+// is moved once. pred receives a const void * to each element in order, along with the
+// unchanged ctx. if the d_array is a pointer type, the memory pointed to by each
+// removed element is freed. da is resized at most once. returns no. elements removed.
+size_t d_array__remove_if(d_array *da, int (*pred)(const void *, void *), void *ctx);
+// for d_array da, removes the n elements whose indices are given in idx, in one stable
+// pass, the same way as d_array__remove_if. idx does not need to be sorted (it is
+// sorted in a copy if it is not), and repeated indices are only removed once. each
+// index must be less than da->siz. returns no. elements removed.
+size_t d_array__remove_many(d_array *da, const size_t *idx, size_t n);
+// sorts da in ascending order. if cmp is NULL, da must be one of the default types
+// int, long, or double, which are LSD radix sorted: O(da->siz) and stable, with no
+// function call per comparison. doubles are sorted by value with -0 before 0 and NaNs
+// at the ends (NaNs with the sign bit set first, the others last). else elements are
+// sorted with qsort and cmp, which is called like the comparator of qsort and need not
+// be stable. the radix sort takes da->siz elements of scratch memory from the
+// allocator of da.
+void d_array__sort(d_array *da, int (*cmp)(const void *, const void *));
+// same as d_array__sort, but splits da into up to n_thr runs that are sorted on their
+// own threads, then merges pairs of runs on their own threads until one run is left.
+// each thread gets at least D_ARRAY__SORT_MT_MIN elements, and with n_thr <= 1 (or a
+// small da) this is simply d_array__sort. the result is the same as that of
+// d_array__sort, except that with cmp it is a merge of qsort runs (so equal elements
+// of different runs keep their order). takes da->siz elements of scratch memory from
+// the allocator of da.
+void d_array__sort_mt(d_array *da, int (*cmp)(const void *, const void *), int n_thr);
+// returns the index of the first element of the sorted da that is not less than the
+// element at key, or da->siz if there is none, with O(log(da->siz)) comparisons. cmp is
+// the comparator da was sorted with; if cmp is NULL, da must be one of the default
+// types int, long, or double and sorted by d_array__sort without a comparator, and
+// elements are compared directly, in the same order as d_array__sort.
+size_t d_array__lower_bound(d_array *da, const void *key,
+			    int (*cmp)(const void *, const void *));
+// returns a void * to an element of the sorted da that is equal to the element at key,
+// or NULL if there is none. cmp is the same as for d_array__lower_bound; if there are
+// several equal elements, the first one is returned.
+void *d_array__bsearch(d_array *da, const void *key,
+		       int (*cmp)(const void *, const void *));
 // returns a void * to the element in d_array da located at index i
 void *d_array__get(d_array *da, size_t i);
 // for an element located at address p, for d_array da, the ith element of da will be
@@ -194,6 +388,70 @@ void d_array__getcpy(void *p, d_array *da, size_t i);
 void d_array__set(d_array *da, size_t i, void *p);
 // frees a d_array struct. if the d_array is a pointer type, it is assumed that each
 // pointer element in the d_array points to some malloc'd memory, which will be freed.
+// the d_array struct and its elements are released through the allocator of da.
 void d_array__free(d_array *da);
 
+/*
+   unchecked inline accessors and iterators for hot loops. these do no NULL or bounds
+   checks at all and are inlined, so a loop over them costs about as much as a loop over
+   da->a itself. use them only with indices known to be in [0, da->siz).
+*/
+
+// returns a void * to the element of da at index i, without any checks
+static inline void *d_array__get_u(d_array *da, size_t i) {
+    return (char *) da->a + i * da->e_siz;
+}
+// writes the element of da at index i to the address at p, without any checks
+static inline void d_array__getcpy_u(void *p, d_array *da, size_t i) {
+    memcpy(p, (char *) da->a + i * da->e_siz, da->e_siz);
+}
+// overwrites the element of da at index i with da->e_siz bytes from p, without any
+// checks
+static inline void d_array__set_u(d_array *da, size_t i, const void *p) {
+    memcpy((char *) da->a + i * da->e_siz, p, da->e_siz);
+}
+// returns a pointer to the first element of da
+static inline void *d_array__begin(d_array *da) {
+    return da->a;
+}
+// returns a pointer just past the last element of da. it is invalidated, like every
+// pointer into da->a, by anything that can resize da.
+static inline void *d_array__end(d_array *da) {
+    return (char *) da->a + da->siz * da->e_siz;
+}
+// returns a pointer to the element after the one at it
+static inline void *d_array__next(d_array *da, void *it) {
+    return (char *) it + da->e_siz;
+}
+// loops with the T * p over every element of da, where T is the element type of da.
+// ex. long s = 0; D_ARRAY__FOREACH(int, p, da) { s += *p; }
+#define D_ARRAY__FOREACH(T, p, da) \
+    for (T *p = (T *) d_array__begin(da), *p##__end = (T *) d_array__end(da); \
+	 p != p##__end; p++)
+
+/*
+   with D_ARRAY__RELEASE defined before d_array.h is included (ex. with
+   -DD_ARRAY__RELEASE), d_array__get, d_array__getcpy, and d_array__set become inline
+   functions that assert their arguments instead of printing an error and exiting, so
+   that with -DNDEBUG as well they do no checks at all. the out-of-line functions can
+   still be called as (d_array__get)(da, i), ex. to take their address.
+*/
+#ifdef D_ARRAY__RELEASE
+static inline void *d_array__get_a(d_array *da, size_t i) {
+    assert(da != NULL && i < da->siz);
+    return d_array__get_u(da, i);
+}
+static inline void d_array__getcpy_a(void *p, d_array *da, size_t i) {
+    assert(p != NULL && da != NULL && i < da->siz);
+    d_array__getcpy_u(p, da, i);
+}
+static inline void d_array__set_a(d_array *da, size_t i, const void *p) {
+    assert(da != NULL && p != NULL && i < da->siz);
+    d_array__set_u(da, i, p);
+}
+#define d_array__get(da, i) d_array__get_a(da, i)
+#define d_array__getcpy(p, da, i) d_array__getcpy_a(p, da, i)
+#define d_array__set(da, i, p) d_array__set_a(da, i, p)
+#endif /* D_ARRAY__RELEASE */
+
 #endif /* D_ARRAY_H */
@@ -0,0 +1,271 @@
+/**
+ * d_array_t.h
+ *
+ * type-specialized versions of the d_array, generated at compile time with macros.
+ * the generic d_array in d_array.h only knows its element size at runtime, so every
+ * access multiplies by da->e_siz, copies elements with memcpy, and prints elements
+ * through the __tostr_el function pointer. for a d_array_T generated here, the element
+ * type T is known to the compiler, so accesses are plain typed loads and stores and
+ * loops over the elements can be vectorized.
+ *
+ * D_ARRAY_DECLARE_N(T, N, fmt...) generates struct d_array_N, holding elements of type
+ * T, and static inline functions d_array_N__new, d_array_N__insert, etc. with the same
+ * names, argument order, and error behavior as their d_array counterparts, except that
+ * elements are passed by value. fmt is one of the D_ARRAY__* macros (ex. D_ARRAY__INT)
+ * or the equivalent arguments for a user-defined type, and is only used by
+ * d_array_N__tostr and d_array_N__view. D_ARRAY_DECLARE(T) can be used for a user type
+ * that is a single identifier and does not need to be printed.
+ *
+ * d_array_int, d_array_char, d_array_long, and d_array_double are declared by this
+ * header through the X-macro D_ARRAY__T_LIST. pointer types are not generated, since
+ * the generic d_array frees the memory pointed to by its elements and a d_array_T does
+ * not manage the memory of its elements.
+ *
+ * sample usage:
+ *
+ * size_t i;
+ * long s;
+ * d_array_int *da;
+ * da = d_array_int__new(DEFAULT_SIZ);
+ * for (i = 0; i < 100; i++) {
+ *     d_array_int__append(da, (int) i);
+ * }
+ * s = 0;
+ * for (i = 0; i < da->siz; i++) {
+ *     s = s + da->a[i];
+ * }
+ * d_array_int__free(da);
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#ifndef D_ARRAY_T_H
+#define D_ARRAY_T_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "d_array.h"
+
+// returns a d_array struct (not a pointer!) that shares memory with the array a of siz
+// elements and max_siz capacity, with the remaining members given in the same format
+// as d_array__new. used to call generic d_array functions that do not change the
+// size of the d_array, like d_array__tostr, on a d_array_T.
+static inline d_array d_array__view(void *a, size_t siz, size_t max_siz, size_t e,
+				    char *(*__tef)(const void *), const char *__t,
+				    char __sep, char __pr_c, char __ps_c) {
+    d_array v;
+    v.a = a;
+    v.e_siz = e;
+    v.siz = siz;
+    v.max_siz = max_siz;
+    v.__tostr_el = __tef;
+    v.t__ = (char *) __t;
+    v.__sep = __sep;
+    v.__pr_c = __pr_c;
+    v.__ps_c = __ps_c;
+    v.__al = &d_alloc__std;
+    v.__pol = (d_array_policy) {D_ARRAY__POLICY__DEFAULT};
+    v.n_realloc = 0;
+    v.b_moved = 0;
+    v.__wrstr_el = NULL;
+    return v;
+}
+
+// generates struct d_array_N with elements of type T, and its functions. the trailing
+// arguments give the element format in the same way as the D_ARRAY__* macros.
+#define D_ARRAY_DECLARE_N(T, N, ...) \
+    struct d_array_##N { \
+	/* typed array of elements */ \
+	T *a; \
+	/* no. elements in d_array_N, no. elements d_array_N can hold before resizing */ \
+	size_t siz, max_siz; \
+    }; \
+    typedef struct d_array_##N d_array_##N; \
+    /* creates a new d_array_N that can hold n elements before a resize is needed */ \
+    static inline d_array_##N *d_array_##N##__new(size_t n) { \
+	d_array_##N *da; \
+	if (n < 1) { \
+	    fprintf(stderr, "%s: number of starting elements must be positive\n", \
+		    "d_array_" #N "__new"); \
+	    exit(1); \
+	} \
+	da = (d_array_##N *) malloc(sizeof(d_array_##N)); \
+	if (da == NULL) { \
+	    fprintf(stderr, "%s: malloc error when allocating d_array_" #N "\n", \
+		    "d_array_" #N "__new"); \
+	    exit(2); \
+	} \
+	da->a = (T *) malloc(n * sizeof(T)); \
+	if (da->a == NULL) { \
+	    fprintf(stderr, "%s: malloc error when allocating memory at %p->a\n", \
+		    "d_array_" #N "__new", (void *) da); \
+	    exit(2); \
+	} \
+	da->siz = 0; \
+	da->max_siz = n; \
+	return da; \
+    } \
+    /* doubles capacity of da until it can hold n elements, reallocating once */ \
+    static inline void d_array_##N##__grow(d_array_##N *da, size_t n, const char *fn) { \
+	if (n <= da->max_siz) { \
+	    return; \
+	} \
+	while (n > da->max_siz) { \
+	    da->max_siz *= 2; \
+	} \
+	da->a = (T *) realloc(da->a, da->max_siz * sizeof(T)); \
+	if (da->a == NULL) { \
+	    fprintf(stderr, "%s: realloc failure growing d_array_" #N " at %p\n", \
+		    fn, (void *) da); \
+	    exit(2); \
+	} \
+    } \
+    /* halves capacity of da while da->siz <= da->max_siz / 4, reallocating once */ \
+    static inline void d_array_##N##__shrink(d_array_##N *da, const char *fn) { \
+	size_t n_max = da->max_siz; \
+	while (n_max > 1 && da->siz <= n_max / 4) { \
+	    n_max /= 2; \
+	} \
+	if (n_max == da->max_siz) { \
+	    return; \
+	} \
+	da->max_siz = n_max; \
+	da->a = (T *) realloc(da->a, da->max_siz * sizeof(T)); \
+	if (da->a == NULL) { \
+	    fprintf(stderr, "%s: realloc failure halving size of d_array_" #N " at %p\n", \
+		    fn, (void *) da); \
+	    exit(2); \
+	} \
+    } \
+    /* exits with an error message if i is not a valid index of da */ \
+    static inline void d_array_##N##__check(d_array_##N *da, size_t i, const char *fn) { \
+	if (da == NULL) { \
+	    fprintf(stderr, "%s: null d_array_" #N "\n", fn); \
+	    exit(1); \
+	} \
+	if (i > da->siz - 1 || da->siz == 0) { \
+	    fprintf(stderr, "%s: index %lu outside of defined bounds of d_array_" #N \
+		    " at %p\n", fn, (unsigned long) i, (void *) da); \
+	    exit(1); \
+	} \
+    } \
+    /* inserts e at index i, where i < da->siz, shifting the tail right by 1 */ \
+    static inline void d_array_##N##__insert(d_array_##N *da, T e, size_t i) { \
+	d_array_##N##__check(da, i, "d_array_" #N "__insert"); \
+	d_array_##N##__grow(da, da->siz + 1, "d_array_" #N "__insert"); \
+	memmove(da->a + i + 1, da->a + i, (da->siz - i) * sizeof(T)); \
+	da->a[i] = e; \
+	++da->siz; \
+    } \
+    /* appends e at index da->siz */ \
+    static inline void d_array_##N##__append(d_array_##N *da, T e) { \
+	if (da == NULL) { \
+	    fprintf(stderr, "%s: cannot append element onto null d_array_" #N "\n", \
+		    "d_array_" #N "__append"); \
+	    exit(1); \
+	} \
+	if (da->siz == da->max_siz) { \
+	    d_array_##N##__grow(da, da->siz + 1, "d_array_" #N "__append"); \
+	} \
+	da->a[da->siz++] = e; \
+    } \
+    /* removes the element at index i, shifting the tail left by 1 */ \
+    static inline void d_array_##N##__remove(d_array_##N *da, size_t i) { \
+	d_array_##N##__check(da, i, "d_array_" #N "__remove"); \
+	memmove(da->a + i, da->a + i + 1, (da->siz - i - 1) * sizeof(T)); \
+	--da->siz; \
+	d_array_##N##__shrink(da, "d_array_" #N "__remove"); \
+    } \
+    /* appends the n elements at e */ \
+    static inline void d_array_##N##__append_n(d_array_##N *da, const T *e, size_t n) { \
+	if (da == NULL || (e == NULL && n > 0)) { \
+	    fprintf(stderr, "%s: cannot append null elements or onto null d_array_" \
+		    #N "\n", "d_array_" #N "__append_n"); \
+	    exit(1); \
+	} \
+	d_array_##N##__grow(da, da->siz + n, "d_array_" #N "__append_n"); \
+	memcpy(da->a + da->siz, e, n * sizeof(T)); \
+	da->siz += n; \
+    } \
+    /* inserts the n elements at e at index i, where i <= da->siz */ \
+    static inline void d_array_##N##__insert_range(d_array_##N *da, const T *e, \
+						   size_t n, size_t i) { \
+	if (da == NULL || i > da->siz || (e == NULL && n > 0)) { \
+	    fprintf(stderr, "%s: cannot insert null elements or outside of defined " \
+		    "array bounds of d_array_" #N "\n", "d_array_" #N "__insert_range"); \
+	    exit(1); \
+	} \
+	d_array_##N##__grow(da, da->siz + n, "d_array_" #N "__insert_range"); \
+	memmove(da->a + i + n, da->a + i, (da->siz - i) * sizeof(T)); \
+	memcpy(da->a + i, e, n * sizeof(T)); \
+	da->siz += n; \
+    } \
+    /* removes elements si to ei - 1, where si <= ei <= da->siz */ \
+    static inline void d_array_##N##__remove_range(d_array_##N *da, size_t si, \
+						   size_t ei) { \
+	if (da == NULL || si > ei || ei > da->siz) { \
+	    fprintf(stderr, "%s: cannot remove elements from outside defined array " \
+		    "bounds of d_array_" #N "\n", "d_array_" #N "__remove_range"); \
+	    exit(1); \
+	} \
+	memmove(da->a + si, da->a + ei, (da->siz - ei) * sizeof(T)); \
+	da->siz -= ei - si; \
+	d_array_##N##__shrink(da, "d_array_" #N "__remove_range"); \
+    } \
+    /* returns a pointer to the element at index i */ \
+    static inline T *d_array_##N##__get(d_array_##N *da, size_t i) { \
+	d_array_##N##__check(da, i, "d_array_" #N "__get"); \
+	return da->a + i; \
+    } \
+    /* writes the element at index i to p */ \
+    static inline void d_array_##N##__getcpy(T *p, d_array_##N *da, size_t i) { \
+	d_array_##N##__check(da, i, "d_array_" #N "__getcpy"); \
+	*p = da->a[i]; \
+    } \
+    /* overwrites the element at index i with e */ \
+    static inline void d_array_##N##__set(d_array_##N *da, size_t i, T e) { \
+	d_array_##N##__check(da, i, "d_array_" #N "__set"); \
+	da->a[i] = e; \
+    } \
+    /* returns a d_array sharing memory with da; see d_array__view */ \
+    static inline d_array d_array_##N##__view(d_array_##N *da) { \
+	return d_array__view(da->a, da->siz, da->max_siz, __VA_ARGS__); \
+    } \
+    /* same as d_array__tostr; must free() the returned string */ \
+    static inline char *d_array_##N##__tostr(d_array_##N *da, size_t si, size_t ei) { \
+	d_array v = d_array_##N##__view(da); \
+	return d_array__tostr(&v, si, ei); \
+    } \
+    /* frees a d_array_N */ \
+    static inline void d_array_##N##__free(d_array_##N *da) { \
+	if (da == NULL || da->a == NULL) { \
+	    fprintf(stderr, "%s: cannot free null pointer\n", "d_array_" #N "__free"); \
+	    exit(1); \
+	} \
+	free(da->a); \
+	free(da); \
+    }
+
+// generates d_array_T for a user-defined type T that is a single identifier, with no
+// __tostr_el function (so d_array_T__tostr cannot be used on it)
+#define D_ARRAY_DECLARE(T) \
+    D_ARRAY_DECLARE_N(T, T, sizeof(T), NULL, #T, '\0', '\0', '\0')
+
+// X-macro list of the default d_array types that have a d_array_T generated for them;
+// each entry gives the type, the name suffix, and the D_ARRAY__* format macro
+#define D_ARRAY__T_LIST(X) \
+    X(int, int, D_ARRAY__INT) \
+    X(char, char, D_ARRAY__CHAR) \
+    X(long, long, D_ARRAY__LONG) \
+    X(double, double, D_ARRAY__DOUBLE)
+
+D_ARRAY__T_LIST(D_ARRAY_DECLARE_N)
+
+#endif /* D_ARRAY_T_H */
@@ -0,0 +1,435 @@
+/**
+ * d_fmt.c
+ *
+ * fast number to string conversions for the d_array package, used by the default
+ * __wrstr_el__* and __tostr_el__* functions. integers are written two digits at a time
+ * from a table of the 100 two-digit strings, which halves the no. divisions compared to
+ * writing one digit at a time (and skips the format string parsing of sprintf).
+ * doubles are written with the Grisu2 algorithm (F. Loitsch, "Printing Floating-Point
+ * Numbers Quickly and Accurately with Integers", PLDI 2010), which uses only 64-bit
+ * integer arithmetic and a table of cached powers of 10 to find a short string of
+ * digits that reads back (with strtod) as exactly the same double. the digits are
+ * the shortest possible ones for almost all doubles; for the rest, one digit more.
+ *
+ * source file that contains function definitions.
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "d_fmt.h"
+
+// the strings "00" to "99", back to back
+static const char d_fmt__digits2[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// writes u in decimal into s, two digits at a time from the back
+size_t d_fmt__ultoa(char *s, unsigned long u) {
+    // no. digits in u
+    size_t n, i;
+    unsigned long t;
+    n = 1;
+    for (t = u; t >= 10; t = t / 10) {
+	n++;
+    }
+    i = n;
+    while (u >= 100) {
+	t = (u % 100) * 2;
+	u = u / 100;
+	s[--i] = d_fmt__digits2[t + 1];
+	s[--i] = d_fmt__digits2[t];
+    }
+    if (u >= 10) {
+	s[1] = d_fmt__digits2[2 * u + 1];
+	s[0] = d_fmt__digits2[2 * u];
+    }
+    else {
+	s[0] = (char) ('0' + u);
+    }
+    return n;
+}
+
+// writes k in decimal into s; negates in unsigned arithmetic so that LONG_MIN works
+size_t d_fmt__ltoa(char *s, long k) {
+    if (k < 0) {
+	*s = '-';
+	return 1 + d_fmt__ultoa(s + 1, -((unsigned long) k));
+    }
+    return d_fmt__ultoa(s, (unsigned long) k);
+}
+
+/* Grisu2. a d_fmt__fp is the value f * 2^e, with a 64-bit significand f. */
+
+struct d_fmt__fp {
+    uint64_t f;
+    int e;
+};
+typedef struct d_fmt__fp d_fmt__fp;
+
+// cached power of 10: 10^k is about f * 2^e, with f normalized (high bit set)
+struct d_fmt__pow {
+    uint64_t f;
+    int e, k;
+};
+
+// the binary exponent of every product of a scaled boundary with a cached power is in
+// [D_FMT__ALPHA, D_FMT__GAMMA], so that the integral part of the product fits in 32 bits
+#define D_FMT__ALPHA -60
+#define D_FMT__GAMMA -32
+// decimal exponent of the first cached power, and decimal exponent step between them
+#define D_FMT__POW_MIN_K -348
+#define D_FMT__POW_STEP_K 8
+
+// 10^k for k = -348, -340, ..., 340, rounded to 64 bits (generated with exact integer
+// arithmetic)
+static const struct d_fmt__pow d_fmt__pows[] = {
+    {0xFA8FD5A0081C0288ULL, -1220, -348},
+    {0xBAAEE17FA23EBF76ULL, -1193, -340},
+    {0x8B16FB203055AC76ULL, -1166, -332},
+    {0xCF42894A5DCE35EAULL, -1140, -324},
+    {0x9A6BB0AA55653B2DULL, -1113, -316},
+    {0xE61ACF033D1A45DFULL, -1087, -308},
+    {0xAB70FE17C79AC6CAULL, -1060, -300},
+    {0xFF77B1FCBEBCDC4FULL, -1034, -292},
+    {0xBE5691EF416BD60CULL, -1007, -284},
+    {0x8DD01FAD907FFC3CULL, -980, -276},
+    {0xD3515C2831559A83ULL, -954, -268},
+    {0x9D71AC8FADA6C9B5ULL, -927, -260},
+    {0xEA9C227723EE8BCBULL, -901, -252},
+    {0xAECC49914078536DULL, -874, -244},
+    {0x823C12795DB6CE57ULL, -847, -236},
+    {0xC21094364DFB5637ULL, -821, -228},
+    {0x9096EA6F3848984FULL, -794, -220},
+    {0xD77485CB25823AC7ULL, -768, -212},
+    {0xA086CFCD97BF97F4ULL, -741, -204},
+    {0xEF340A98172AACE5ULL, -715, -196},
+    {0xB23867FB2A35B28EULL, -688, -188},
+    {0x84C8D4DFD2C63F3BULL, -661, -180},
+    {0xC5DD44271AD3CDBAULL, -635, -172},
+    {0x936B9FCEBB25C996ULL, -608, -164},
+    {0xDBAC6C247D62A584ULL, -582, -156},
+    {0xA3AB66580D5FDAF6ULL, -555, -148},
+    {0xF3E2F893DEC3F126ULL, -529, -140},
+    {0xB5B5ADA8AAFF80B8ULL, -502, -132},
+    {0x87625F056C7C4A8BULL, -475, -124},
+    {0xC9BCFF6034C13053ULL, -449, -116},
+    {0x964E858C91BA2655ULL, -422, -108},
+    {0xDFF9772470297EBDULL, -396, -100},
+    {0xA6DFBD9FB8E5B88FULL, -369, -92},
+    {0xF8A95FCF88747D94ULL, -343, -84},
+    {0xB94470938FA89BCFULL, -316, -76},
+    {0x8A08F0F8BF0F156BULL, -289, -68},
+    {0xCDB02555653131B6ULL, -263, -60},
+    {0x993FE2C6D07B7FACULL, -236, -52},
+    {0xE45C10C42A2B3B06ULL, -210, -44},
+    {0xAA242499697392D3ULL, -183, -36},
+    {0xFD87B5F28300CA0EULL, -157, -28},
+    {0xBCE5086492111AEBULL, -130, -20},
+    {0x8CBCCC096F5088CCULL, -103, -12},
+    {0xD1B71758E219652CULL, -77, -4},
+    {0x9C40000000000000ULL, -50, 4},
+    {0xE8D4A51000000000ULL, -24, 12},
+    {0xAD78EBC5AC620000ULL, 3, 20},
+    {0x813F3978F8940984ULL, 30, 28},
+    {0xC097CE7BC90715B3ULL, 56, 36},
+    {0x8F7E32CE7BEA5C70ULL, 83, 44},
+    {0xD5D238A4ABE98068ULL, 109, 52},
+    {0x9F4F2726179A2245ULL, 136, 60},
+    {0xED63A231D4C4FB27ULL, 162, 68},
+    {0xB0DE65388CC8ADA8ULL, 189, 76},
+    {0x83C7088E1AAB65DBULL, 216, 84},
+    {0xC45D1DF942711D9AULL, 242, 92},
+    {0x924D692CA61BE758ULL, 269, 100},
+    {0xDA01EE641A708DEAULL, 295, 108},
+    {0xA26DA3999AEF774AULL, 322, 116},
+    {0xF209787BB47D6B85ULL, 348, 124},
+    {0xB454E4A179DD1877ULL, 375, 132},
+    {0x865B86925B9BC5C2ULL, 402, 140},
+    {0xC83553C5C8965D3DULL, 428, 148},
+    {0x952AB45CFA97A0B3ULL, 455, 156},
+    {0xDE469FBD99A05FE3ULL, 481, 164},
+    {0xA59BC234DB398C25ULL, 508, 172},
+    {0xF6C69A72A3989F5CULL, 534, 180},
+    {0xB7DCBF5354E9BECEULL, 561, 188},
+    {0x88FCF317F22241E2ULL, 588, 196},
+    {0xCC20CE9BD35C78A5ULL, 614, 204},
+    {0x98165AF37B2153DFULL, 641, 212},
+    {0xE2A0B5DC971F303AULL, 667, 220},
+    {0xA8D9D1535CE3B396ULL, 694, 228},
+    {0xFB9B7CD9A4A7443CULL, 720, 236},
+    {0xBB764C4CA7A44410ULL, 747, 244},
+    {0x8BAB8EEFB6409C1AULL, 774, 252},
+    {0xD01FEF10A657842CULL, 800, 260},
+    {0x9B10A4E5E9913129ULL, 827, 268},
+    {0xE7109BFBA19C0C9DULL, 853, 276},
+    {0xAC2820D9623BF429ULL, 880, 284},
+    {0x80444B5E7AA7CF85ULL, 907, 292},
+    {0xBF21E44003ACDD2DULL, 933, 300},
+    {0x8E679C2F5E44FF8FULL, 960, 308},
+    {0xD433179D9C8CB841ULL, 986, 316},
+    {0x9E19DB92B4E31BA9ULL, 1013, 324},
+    {0xEB96BF6EBADF77D9ULL, 1039, 332},
+    {0xAF87023B9BF0EE6BULL, 1066, 340}
+};
+
+// returns x - y, where x.e == y.e and x.f >= y.f
+static d_fmt__fp d_fmt__fp_sub(d_fmt__fp x, d_fmt__fp y) {
+    d_fmt__fp r;
+    r.f = x.f - y.f;
+    r.e = x.e;
+    return r;
+}
+
+// returns x * y, rounded to the upper 64 bits of the 128-bit product
+static d_fmt__fp d_fmt__fp_mul(d_fmt__fp x, d_fmt__fp y) {
+    uint64_t x_h, x_l, y_h, y_l, p_hh, p_hl, p_lh, p_ll, m;
+    d_fmt__fp r;
+    x_h = x.f >> 32;
+    x_l = x.f & 0xFFFFFFFFu;
+    y_h = y.f >> 32;
+    y_l = y.f & 0xFFFFFFFFu;
+    p_hh = x_h * y_h;
+    p_hl = x_h * y_l;
+    p_lh = x_l * y_h;
+    p_ll = x_l * y_l;
+    // middle 32 bits of the product, plus 2^31 to round the lower 64 bits away
+    m = (p_ll >> 32) + (p_hl & 0xFFFFFFFFu) + (p_lh & 0xFFFFFFFFu) + (1u << 31);
+    r.f = p_hh + (p_hl >> 32) + (p_lh >> 32) + (m >> 32);
+    r.e = x.e + y.e + 64;
+    return r;
+}
+
+// returns x shifted left until the high bit of x.f is set; x.f must be nonzero
+static d_fmt__fp d_fmt__fp_norm(d_fmt__fp x) {
+    while ((x.f >> 63) == 0) {
+	x.f = x.f << 1;
+	x.e--;
+    }
+    return x;
+}
+
+// returns x shifted left so that its exponent is e, where e <= x.e
+static d_fmt__fp d_fmt__fp_norm_to(d_fmt__fp x, int e) {
+    x.f = x.f << (x.e - e);
+    x.e = e;
+    return x;
+}
+
+// sets *w to the finite, positive double d, and *m_m and *m_p to the lower and upper
+// boundaries of d (halfway to the next smaller and larger doubles), so that any number
+// strictly between them reads back as d. *w and *m_p are normalized, and *m_m has the
+// same exponent as *m_p.
+static void d_fmt__bounds(double d, d_fmt__fp *m_m, d_fmt__fp *w, d_fmt__fp *m_p) {
+    uint64_t b, f;
+    int e;
+    d_fmt__fp v, l, u;
+    memcpy(&b, &d, sizeof(b));
+    f = b & ((((uint64_t) 1) << 52) - 1);
+    e = (int) (b >> 52);
+    // subnormal, else add the hidden bit
+    if (e == 0) {
+	v.f = f;
+	v.e = 1 - 1075;
+    }
+    else {
+	v.f = f | (((uint64_t) 1) << 52);
+	v.e = e - 1075;
+    }
+    u.f = 2 * v.f + 1;
+    u.e = v.e - 1;
+    // for a power of 2 the next smaller double is closer than the next larger one
+    if (f == 0 && e > 1) {
+	l.f = 4 * v.f - 1;
+	l.e = v.e - 2;
+    }
+    else {
+	l.f = 2 * v.f - 1;
+	l.e = v.e - 1;
+    }
+    *m_p = d_fmt__fp_norm(u);
+    *m_m = d_fmt__fp_norm_to(l, m_p->e);
+    *w = d_fmt__fp_norm(v);
+}
+
+// returns the cached power c such that e + c.e + 64 is in [D_FMT__ALPHA, D_FMT__GAMMA]
+static const struct d_fmt__pow *d_fmt__pow_for(int e) {
+    int f, k;
+    // k = ceil((D_FMT__ALPHA - e - 1) * log10(2)), with 78913 / 2^18 close to log10(2)
+    f = D_FMT__ALPHA - e - 1;
+    k = (f * 78913) / (1 << 18) + (f > 0);
+    return d_fmt__pows + (-D_FMT__POW_MIN_K + k + (D_FMT__POW_STEP_K - 1)) /
+	D_FMT__POW_STEP_K;
+}
+
+// moves the last digit of s[0 .. n - 1] down while that brings it closer to w, whose
+// distance from the upper boundary is dist, without leaving the range delta.
+// rest is the distance of the digits from the upper boundary and ten_k the value of
+// one unit of the last digit.
+static void d_fmt__round(char *s, size_t n, uint64_t dist, uint64_t delta,
+			 uint64_t rest, uint64_t ten_k) {
+    while (rest < dist && delta - rest >= ten_k &&
+	   (rest + ten_k < dist || dist - rest > rest + ten_k - dist)) {
+	s[n - 1]--;
+	rest += ten_k;
+    }
+}
+
+// generates into s the digits of a number in (m_m, m_p), as close to w as possible, and
+// returns the no. digits. *k is the decimal exponent of the scaled numbers on entry,
+// and that of the last digit on return.
+static size_t d_fmt__digits(char *s, int *k, d_fmt__fp m_m, d_fmt__fp w,
+			    d_fmt__fp m_p) {
+    uint64_t delta, dist, one_f, p2, rest, pow10;
+    uint32_t p1, d;
+    int one_e, m;
+    size_t n, n_d;
+    delta = d_fmt__fp_sub(m_p, m_m).f;
+    dist = d_fmt__fp_sub(m_p, w).f;
+    // one = 2^-e; p1 is the integral part of m_p and p2 the fractional part
+    one_e = -m_p.e;
+    one_f = ((uint64_t) 1) << one_e;
+    p1 = (uint32_t) (m_p.f >> one_e);
+    p2 = m_p.f & (one_f - 1);
+    // no. digits of p1, and 10^(n_d - 1)
+    n_d = 1;
+    pow10 = 1;
+    while (n_d < 10 && p1 >= pow10 * 10) {
+	pow10 = pow10 * 10;
+	n_d++;
+    }
+    n = 0;
+    // digits of the integral part
+    while (n_d > 0) {
+	d = (uint32_t) (p1 / pow10);
+	p1 = (uint32_t) (p1 % pow10);
+	s[n++] = (char) ('0' + d);
+	n_d--;
+	rest = (((uint64_t) p1) << one_e) + p2;
+	// stop as soon as the digits so far are inside the boundaries
+	if (rest <= delta) {
+	    *k += (int) n_d;
+	    d_fmt__round(s, n, dist, delta, rest, pow10 << one_e);
+	    return n;
+	}
+	pow10 = pow10 / 10;
+    }
+    // digits of the fractional part
+    m = 0;
+    for (;;) {
+	p2 = p2 * 10;
+	d = (uint32_t) (p2 >> one_e);
+	p2 = p2 & (one_f - 1);
+	s[n++] = (char) ('0' + d);
+	m++;
+	delta = delta * 10;
+	dist = dist * 10;
+	if (p2 <= delta) {
+	    break;
+	}
+    }
+    *k -= m;
+    d_fmt__round(s, n, dist, delta, p2, one_f);
+    return n;
+}
+
+// writes the exponent x as e+XX or e-XX (at least two digits) into s, and returns the
+// no. chars written
+static size_t d_fmt__exp(char *s, int x) {
+    size_t n = 0;
+    s[n++] = 'e';
+    if (x < 0) {
+	s[n++] = '-';
+	x = -x;
+    }
+    else {
+	s[n++] = '+';
+    }
+    if (x < 10) {
+	s[n++] = '0';
+    }
+    return n + d_fmt__ultoa(s + n, (unsigned long) x);
+}
+
+// writes the shortest string that reads back as d into s
+size_t d_fmt__dtoa(char *s, double d) {
+    d_fmt__fp m_m, w, m_p, c;
+    const struct d_fmt__pow *cp;
+    // digits, no. chars written, no. digits, decimal exponent of the last digit,
+    // decimal exponent of the first digit + 1 (position of the decimal point)
+    char g[20];
+    size_t n, n_g;
+    int k, p;
+    n = 0;
+    // NaN is the only double that is not equal to itself
+    if (d != d) {
+	memcpy(s, "nan", 3);
+	return 3;
+    }
+    if (signbit(d)) {
+	s[n++] = '-';
+	d = -d;
+    }
+    if (d == 0) {
+	s[n++] = '0';
+	return n;
+    }
+    if (isinf(d)) {
+	memcpy(s + n, "inf", 3);
+	return n + 3;
+    }
+    // scale the boundaries by the cached power and generate the digits
+    d_fmt__bounds(d, &m_m, &w, &m_p);
+    cp = d_fmt__pow_for(m_p.e);
+    c.f = cp->f;
+    c.e = cp->e;
+    w = d_fmt__fp_mul(w, c);
+    m_m = d_fmt__fp_mul(m_m, c);
+    m_p = d_fmt__fp_mul(m_p, c);
+    // shrink the boundaries by one unit each, since the products were rounded
+    m_m.f++;
+    m_p.f--;
+    k = -cp->k;
+    n_g = d_fmt__digits(g, &k, m_m, w, m_p);
+    p = (int) n_g + k;
+    // integer, ex. 1234500
+    if (k >= 0 && p <= 17) {
+	memcpy(s + n, g, n_g);
+	n += n_g;
+	memset(s + n, '0', (size_t) k);
+	return n + (size_t) k;
+    }
+    // decimal point inside the digits, ex. 1234.5
+    if (p > 0 && p <= 17) {
+	memcpy(s + n, g, (size_t) p);
+	s[n + p] = '.';
+	memcpy(s + n + p + 1, g + p, n_g - (size_t) p);
+	return n + n_g + 1;
+    }
+    // decimal point before the digits, ex. 0.0012345
+    if (p > -4 && p <= 0) {
+	s[n++] = '0';
+	s[n++] = '.';
+	memset(s + n, '0', (size_t) -p);
+	n += (size_t) -p;
+	memcpy(s + n, g, n_g);
+	return n + n_g;
+    }
+    // else scientific notation, ex. 1.2345e+300
+    s[n++] = g[0];
+    if (n_g > 1) {
+	s[n++] = '.';
+	memcpy(s + n, g + 1, n_g - 1);
+	n += n_g - 1;
+    }
+    return n + d_fmt__exp(s + n, p - 1);
+}
@@ -0,0 +1,44 @@
+/**
+ * d_fmt.h
+ *
+ * fast number to string conversions for the d_array package, used by the default
+ * __wrstr_el__* and __tostr_el__* functions. integers are written two digits at a time
+ * from a table of the 100 two-digit strings, which halves the no. divisions compared to
+ * writing one digit at a time (and skips the format string parsing of sprintf).
+ * doubles are written with the Grisu2 algorithm (F. Loitsch, "Printing Floating-Point
+ * Numbers Quickly and Accurately with Integers", PLDI 2010), which uses only 64-bit
+ * integer arithmetic and a table of cached powers of 10 to find a short string of
+ * digits that reads back (with strtod) as exactly the same double. the digits are
+ * the shortest possible ones for almost all doubles; for the rest, one digit more.
+ *
+ * header file that contains declarations for functions and macros.
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#ifndef D_FMT_H
+#define D_FMT_H
+// include stddef.h for size_t
+#include <stddef.h>
+// no. chars that is always enough for d_fmt__ultoa, d_fmt__ltoa, and d_fmt__dtoa
+#define D_FMT__BUF_SIZ 32
+// writes u in decimal into s, which must have room for D_FMT__BUF_SIZ chars, without a
+// null-terminating character, and returns the no. chars written
+size_t d_fmt__ultoa(char *s, unsigned long u);
+// same as d_fmt__ultoa, but for signed k. LONG_MIN is handled correctly.
+size_t d_fmt__ltoa(char *s, long k);
+// writes the shortest string that reads back as d into s, which must have room for
+// D_FMT__BUF_SIZ chars, without a null-terminating character, and returns the no. chars
+// written. the format is that of printf's %g without the trailing zeros, but with as
+// many digits as needed: d is written in fixed notation when its decimal exponent is
+// from -4 to 16 (ex. 0.0001, 2.5, 12345678901234567), else in scientific notation with
+// at least two exponent digits (ex. 1e-05, 1.7976931348623157e+308). infinities are
+// written as inf and -inf, NaN as nan, and negative zero as -0.
+size_t d_fmt__dtoa(char *s, double d);
+
+#endif /* D_FMT_H */
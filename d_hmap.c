@@ -0,0 +1,319 @@
+/**
+ * d_hmap.c
+ *
+ * hash map with fixed-size keys and values, using open addressing with linear probing
+ * and backward shift deletion. small values are stored inline in the slots with the
+ * key and its hash; 4 and 8 byte keys with the default callbacks are hashed and
+ * compared as integers. see d_hmap.h.
+ *
+ * source file that contains function definitions.
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "d_hmap.h"
+
+// rounds n up to a multiple of 8, so that keys, values, and slots stay 8 byte aligned
+#define D_HMAP__ROUND(n) (((n) + 7) / 8 * 8)
+// pointer to slot i of hm, and the stored hash of slot i
+#define D_HMAP__SLOT(hm, i) ((char *) (hm)->s + (i) * (hm)->s_siz)
+#define D_HMAP__HASH(hm, i) (*(uint64_t *) D_HMAP__SLOT(hm, i))
+// pointer to the value of slot i of hm, inline or not
+#define D_HMAP__VAL(hm, i) (((hm)->v == NULL) ? D_HMAP__SLOT(hm, i) + (hm)->v_off : \
+			    (char *) (hm)->v + (i) * (hm)->v_siz)
+
+// murmur3 64-bit finalizer; a bijection, so distinct integer keys get distinct hashes.
+// the same as h_mix64 in strh_table.h, which the d_array family does not depend on
+static inline uint64_t d_hmap__fmix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// default hash function: FNV-1a over the n bytes at k, finished with d_hmap__fmix
+static uint64_t d_hmap__hash_bytes(const void *k, size_t n) {
+    const unsigned char *p = (const unsigned char *) k;
+    uint64_t h = 0xcbf29ce484222325ULL;
+    size_t i;
+    for (i = 0; i < n; i++) {
+	h = (h ^ p[i]) * 0x100000001b3ULL;
+    }
+    return d_hmap__fmix(h);
+}
+
+// returns the hash of key k of hm; never 0, which marks an empty slot
+static inline uint64_t d_hmap__hash(d_hmap *hm, const void *k) {
+    uint64_t h;
+    uint32_t k4;
+    if (hm->k_int == 8) {
+	memcpy(&h, k, 8);
+	h = d_hmap__fmix(h);
+    }
+    else if (hm->k_int == 4) {
+	memcpy(&k4, k, 4);
+	h = d_hmap__fmix(k4);
+    }
+    else if (hm->__hf != NULL) {
+	h = hm->__hf(k, hm->k_siz);
+    }
+    else {
+	h = d_hmap__hash_bytes(k, hm->k_siz);
+    }
+    return (h == 0) ? 1 : h;
+}
+
+// returns the slot of hm that holds key k with hash h and sets *f to 1, or returns the
+// empty slot where k would go and sets *f to 0
+static inline size_t d_hmap__find(d_hmap *hm, const void *k, uint64_t h, int *f) {
+    size_t m = hm->cap - 1, i = h & m;
+    uint64_t sh, k8;
+    uint32_t k4;
+    char *s;
+    // integer keys: compare the keys themselves, which are in the same cache line
+    if (hm->k_int == 8) {
+	memcpy(&k8, k, 8);
+	for (;; i = (i + 1) & m) {
+	    s = D_HMAP__SLOT(hm, i);
+	    if (*(uint64_t *) s == 0 || *(uint64_t *) (s + D_HMAP__K_OFF) == k8) {
+		*f = (*(uint64_t *) s != 0);
+		return i;
+	    }
+	}
+    }
+    if (hm->k_int == 4) {
+	memcpy(&k4, k, 4);
+	for (;; i = (i + 1) & m) {
+	    s = D_HMAP__SLOT(hm, i);
+	    if (*(uint64_t *) s == 0 || *(uint32_t *) (s + D_HMAP__K_OFF) == k4) {
+		*f = (*(uint64_t *) s != 0);
+		return i;
+	    }
+	}
+    }
+    // else only call the equality function when the stored hashes match
+    for (;; i = (i + 1) & m) {
+	s = D_HMAP__SLOT(hm, i);
+	sh = *(uint64_t *) s;
+	if (sh == 0) {
+	    *f = 0;
+	    return i;
+	}
+	if (sh == h && ((hm->__eqf != NULL) ? hm->__eqf(s + D_HMAP__K_OFF, k, hm->k_siz) :
+			memcmp(s + D_HMAP__K_OFF, k, hm->k_siz) == 0)) {
+	    *f = 1;
+	    return i;
+	}
+    }
+}
+
+// allocates cap empty slots (and out of line values) for hm
+static void d_hmap__alloc(d_hmap *hm, size_t cap, const char *fn) {
+    hm->cap = cap;
+    hm->max_siz = (size_t) (cap * D_HMAP__MAX_LF);
+    hm->s = calloc(cap, hm->s_siz);
+    // if hm->s is NULL, print error and exit
+    if (hm->s == NULL) {
+	fprintf(stderr, "%s: calloc error when allocating %lu slots of d_hmap at %p\n",
+		fn, (unsigned long) cap, (void *) hm);
+	exit(2);
+    }
+    hm->v = NULL;
+    if (hm->v_siz > D_HMAP__INLINE_SIZ) {
+	hm->v = malloc(cap * hm->v_siz);
+	// if hm->v is NULL, print error and exit
+	if (hm->v == NULL) {
+	    fprintf(stderr, "%s: malloc error when allocating %lu values of d_hmap at "
+		    "%p\n", fn, (unsigned long) cap, (void *) hm);
+	    exit(2);
+	}
+    }
+}
+
+// doubles the no. slots of hm, moving every entry to its slot in the new array. the
+// keys are known to be distinct, so only empty slots are looked for.
+static void d_hmap__grow(d_hmap *hm, const char *fn) {
+    void *o_s = hm->s, *o_v = hm->v;
+    size_t o_cap = hm->cap, i, j, m;
+    char *s;
+    d_hmap__alloc(hm, 2 * o_cap, fn);
+    m = hm->cap - 1;
+    for (i = 0; i < o_cap; i++) {
+	s = (char *) o_s + i * hm->s_siz;
+	if (*(uint64_t *) s == 0) {
+	    continue;
+	}
+	for (j = *(uint64_t *) s & m; D_HMAP__HASH(hm, j) != 0; j = (j + 1) & m)
+	    ;
+	memcpy(D_HMAP__SLOT(hm, j), s, hm->s_siz);
+	if (o_v != NULL) {
+	    memcpy((char *) hm->v + j * hm->v_siz, (char *) o_v + i * hm->v_siz,
+		   hm->v_siz);
+	}
+    }
+    free(o_s);
+    free(o_v);
+}
+
+// creates a new d_hmap that can hold n entries before resizing, with k byte keys and
+// v byte values
+d_hmap *d_hmap__new(size_t n, size_t k, size_t v,
+		    uint64_t (*__hf)(const void *, size_t),
+		    int (*__eqf)(const void *, const void *, size_t)) {
+    size_t cap;
+    // if k < 1, print error and exit
+    if (k < 1) {
+	fprintf(stderr, "%s: key size must be positive\n", D_HMAP__NEW_N);
+	exit(1);
+    }
+    d_hmap *hm = (d_hmap *) malloc(sizeof(d_hmap));
+    // if hm is NULL, print error and exit
+    if (hm == NULL) {
+	fprintf(stderr, "%s: malloc error when allocating d_hmap\n", D_HMAP__NEW_N);
+	exit(2);
+    }
+    hm->k_siz = k;
+    hm->v_siz = v;
+    hm->v_off = D_HMAP__K_OFF + D_HMAP__ROUND(k);
+    hm->s_siz = hm->v_off + ((v <= D_HMAP__INLINE_SIZ) ? D_HMAP__ROUND(v) : 0);
+    hm->siz = 0;
+    hm->__hf = __hf;
+    hm->__eqf = __eqf;
+    hm->k_int = (__hf == NULL && __eqf == NULL && (k == 4 || k == 8)) ? (int) k : 0;
+    // smallest power of 2 no. slots that holds n entries without growing
+    for (cap = 8; cap * D_HMAP__MAX_LF < n; cap *= 2)
+	;
+    d_hmap__alloc(hm, cap, D_HMAP__NEW_N);
+    return hm;
+}
+
+// copies hm->k_siz bytes from k and hm->v_siz bytes from v into hm, overwriting the
+// value if the key is already in hm
+void d_hmap__put(d_hmap *hm, const void *k, const void *v) {
+    // if hm or k is NULL, or v is NULL with nonzero value size, print error and exit
+    if (hm == NULL || k == NULL || (v == NULL && hm->v_siz > 0)) {
+	fprintf(stderr, "%s: null d_hmap, key, or value\n", D_HMAP__PUT_N);
+	exit(1);
+    }
+    uint64_t h = d_hmap__hash(hm, k);
+    int f;
+    size_t i = d_hmap__find(hm, k, h, &f);
+    if (!f) {
+	// grow first if the new entry would pass the max load factor
+	if (hm->siz == hm->max_siz) {
+	    d_hmap__grow(hm, D_HMAP__PUT_N);
+	    i = d_hmap__find(hm, k, h, &f);
+	}
+	D_HMAP__HASH(hm, i) = h;
+	memcpy(D_HMAP__SLOT(hm, i) + D_HMAP__K_OFF, k, hm->k_siz);
+	hm->siz++;
+    }
+    if (hm->v_siz > 0) {
+	memcpy(D_HMAP__VAL(hm, i), v, hm->v_siz);
+    }
+}
+
+// returns a void * to the value of key k in hm, or NULL if k is not in hm
+void *d_hmap__get(d_hmap *hm, const void *k) {
+    // if hm or k is NULL, print error and exit
+    if (hm == NULL || k == NULL) {
+	fprintf(stderr, "%s: null d_hmap or key\n", D_HMAP__GET_N);
+	exit(1);
+    }
+    int f;
+    size_t i = d_hmap__find(hm, k, d_hmap__hash(hm, k), &f);
+    return (f) ? (void *) D_HMAP__VAL(hm, i) : NULL;
+}
+
+// writes the value of key k in hm to the address at p and returns 1, or returns 0 if
+// k is not in hm
+int d_hmap__getcpy(void *p, d_hmap *hm, const void *k) {
+    // if hm, k, or p is NULL, print error and exit
+    if (hm == NULL || k == NULL || p == NULL) {
+	fprintf(stderr, "%s: null d_hmap, key, or destination\n", D_HMAP__GETCPY_N);
+	exit(1);
+    }
+    int f;
+    size_t i = d_hmap__find(hm, k, d_hmap__hash(hm, k), &f);
+    if (f) {
+	memcpy(p, D_HMAP__VAL(hm, i), hm->v_siz);
+    }
+    return f;
+}
+
+// removes key k and its value from hm and returns 1, or returns 0 if k is not in hm.
+// the entries after the removed one, up to the next empty slot, are moved back into
+// the hole when their home slot is not between the hole and their slot, so that every
+// entry can still be reached from its home slot without tombstones.
+int d_hmap__remove(d_hmap *hm, const void *k) {
+    // if hm or k is NULL, print error and exit
+    if (hm == NULL || k == NULL) {
+	fprintf(stderr, "%s: null d_hmap or key\n", D_HMAP__REMOVE_N);
+	exit(1);
+    }
+    int f;
+    size_t m = hm->cap - 1, i, j, home;
+    i = d_hmap__find(hm, k, d_hmap__hash(hm, k), &f);
+    if (!f) {
+	return 0;
+    }
+    for (j = (i + 1) & m; D_HMAP__HASH(hm, j) != 0; j = (j + 1) & m) {
+	home = D_HMAP__HASH(hm, j) & m;
+	// the entry at j may move to i if its probe distance is at least that of i
+	if (((j - home) & m) >= ((j - i) & m)) {
+	    memcpy(D_HMAP__SLOT(hm, i), D_HMAP__SLOT(hm, j), hm->s_siz);
+	    if (hm->v != NULL) {
+		memcpy(D_HMAP__VAL(hm, i), D_HMAP__VAL(hm, j), hm->v_siz);
+	    }
+	    i = j;
+	}
+    }
+    D_HMAP__HASH(hm, i) = 0;
+    hm->siz--;
+    return 1;
+}
+
+// sets *k and *v to the key and value of the first entry in a slot at or after index
+// i, and returns the index after that slot, or returns 0 if there is none
+size_t d_hmap__next(d_hmap *hm, size_t i, void **k, void **v) {
+    // if hm is NULL, print error and exit
+    if (hm == NULL) {
+	fprintf(stderr, "%s: null d_hmap\n", D_HMAP__NEXT_N);
+	exit(1);
+    }
+    for (; i < hm->cap; i++) {
+	if (D_HMAP__HASH(hm, i) != 0) {
+	    if (k != NULL) {
+		*k = D_HMAP__SLOT(hm, i) + D_HMAP__K_OFF;
+	    }
+	    if (v != NULL) {
+		*v = D_HMAP__VAL(hm, i);
+	    }
+	    return i + 1;
+	}
+    }
+    return 0;
+}
+
+// frees a d_hmap. memory pointed to by keys or values is not freed.
+void d_hmap__free(d_hmap *hm) {
+    // if hm is NULL, print error and exit
+    if (hm == NULL) {
+	fprintf(stderr, "%s: cannot free null pointer\n", D_HMAP__FREE_N);
+	exit(1);
+    }
+    free(hm->s);
+    free(hm->v);
+    free(hm);
+}
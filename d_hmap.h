@@ -0,0 +1,107 @@
+/**
+ * d_hmap.h
+ *
+ * hash map with fixed-size keys and values, in the spirit of the d_array: the map only
+ * knows the size of its keys (k_siz) and values (v_siz), and keys and values are
+ * copied in and out of it with memcpy. keys are hashed and compared with user
+ * callbacks, or with the defaults (a hash of the key bytes and memcmp) if the
+ * callbacks are NULL. with the default callbacks, maps with 4 or 8 byte keys (ex. int
+ * or long) take a fast path that hashes and compares the keys as integers.
+ *
+ * the map uses open addressing with linear probing. each slot holds the hash of its
+ * key, the key, and the value if it is at most D_HMAP__INLINE_SIZ bytes, so a lookup
+ * usually touches a single cache line and no entry has memory of its own. larger
+ * values are kept in a separate array with one value per slot, so that they do not
+ * spread out the slots that are probed. removal shifts the entries after the removed
+ * one back instead of leaving tombstones, so lookups never slow down after many
+ * removals.
+ *
+ * header file that contains declarations for functions, macros, and the struct.
+ *
+ * sample usage:
+ *
+ * long k, *v;
+ * d_hmap *hm;
+ * hm = d_hmap__new(DEFAULT_SIZ, sizeof(long), sizeof(long), NULL, NULL);
+ * for (k = 0; k < 100; k++) {
+ *     v = (long *) d_hmap__get(hm, &k);
+ *     if (v == NULL) {
+ *         d_hmap__put(hm, &k, &k);
+ *     }
+ * }
+ * d_hmap__free(hm);
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#ifndef D_HMAP_H
+#define D_HMAP_H
+// include stddef.h for size_t
+#include <stddef.h>
+#include <stdint.h>
+// largest value that is stored inline in a slot
+#define D_HMAP__INLINE_SIZ 16
+// max no. entries per slot before the map doubles its no. slots
+#define D_HMAP__MAX_LF 0.75
+// user function names
+#define D_HMAP__NEW_N "d_hmap__new"
+#define D_HMAP__PUT_N "d_hmap__put"
+#define D_HMAP__GET_N "d_hmap__get"
+#define D_HMAP__GETCPY_N "d_hmap__getcpy"
+#define D_HMAP__REMOVE_N "d_hmap__remove"
+#define D_HMAP__NEXT_N "d_hmap__next"
+#define D_HMAP__FREE_N "d_hmap__free"
+// struct for hash map
+struct d_hmap {
+    // slots, each s_siz bytes: the hash of the key (0 if the slot is empty), the key
+    // at offset D_HMAP__K_OFF, and the value at offset v_off if it is stored inline
+    void *s;
+    // values that are too large to store inline, v_siz bytes per slot, else NULL
+    void *v;
+    // size of each key, each value, and each slot, and offset of inline values
+    size_t k_siz, v_siz, s_siz, v_off;
+    // no. entries in the map, no. slots (a power of 2), no. entries before growing
+    size_t siz, cap, max_siz;
+    // hash function and equality function for keys, or NULL for the defaults
+    uint64_t (*__hf)(const void *k, size_t n);
+    int (*__eqf)(const void *a, const void *b, size_t n);
+    // 4 or 8 if the keys take the integer fast path, else 0
+    int k_int;
+};
+typedef struct d_hmap d_hmap;
+// offset of the key in a slot
+#define D_HMAP__K_OFF sizeof(uint64_t)
+// creates a new d_hmap that can hold n entries before resizing, with k byte keys and
+// v byte values (v may be 0, which makes the map a set). __hf returns the hash of the
+// n byte key at k, and __eqf returns nonzero if the n byte keys at a and b are equal;
+// keys that are equal must have the same hash. if both are NULL, keys are hashed and
+// compared as bytes, and 4 and 8 byte keys are hashed and compared as integers.
+d_hmap *d_hmap__new(size_t n, size_t k, size_t v,
+		    uint64_t (*__hf)(const void *, size_t),
+		    int (*__eqf)(const void *, const void *, size_t));
+// copies hm->k_siz bytes from k and hm->v_siz bytes from v into hm, overwriting the
+// value if the key is already in hm
+void d_hmap__put(d_hmap *hm, const void *k, const void *v);
+// returns a void * to the value of key k in hm, or NULL if k is not in hm. the pointer
+// is valid until the next d_hmap__put or d_hmap__remove on hm.
+void *d_hmap__get(d_hmap *hm, const void *k);
+// writes the value of key k in hm to the address at p and returns 1, or returns 0 if
+// k is not in hm
+int d_hmap__getcpy(void *p, d_hmap *hm, const void *k);
+// removes key k and its value from hm and returns 1, or returns 0 if k is not in hm
+int d_hmap__remove(d_hmap *hm, const void *k);
+// iterates over the entries of hm: sets *k and *v (either may be NULL) to the key and
+// value of the first entry in a slot at or after index i, and returns the index after
+// that slot, or returns 0 if there is none. start with i = 0 and pass the returned
+// index back in, ex. for (i = 0; (i = d_hmap__next(hm, i, &k, &v)) != 0; ) { ... }.
+// hm must not be changed during the iteration.
+size_t d_hmap__next(d_hmap *hm, size_t i, void **k, void **v);
+// frees a d_hmap. memory pointed to by keys or values is not freed.
+void d_hmap__free(d_hmap *hm);
+
+#endif /* D_HMAP_H */
@@ -0,0 +1,213 @@
+/**
+ * d_mmap.c
+ *
+ * binary files for d_arrays, and d_arrays whose elements are memory-mapped from such
+ * a file. see d_mmap.h for the file format and how the mapped d_array behaves.
+ *
+ * source file that contains function definitions.
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "d_mmap.h"
+// for d_array__view
+#include "d_array_t.h"
+
+// fails to compile if the header is not exactly D_MMAP__HDR_SIZ bytes
+typedef char d_mmap__hdr_siz_check[(sizeof(d_mmap_hdr) == D_MMAP__HDR_SIZ) ? 1 : -1];
+
+// a d_array opened by d_array__open_mmap, together with its allocator and mapping. da
+// must come first, since d_array__free hands &da to the allocator to free the struct.
+struct d_mmap {
+    d_array da;
+    d_alloc al;
+    // start and length of the mapping (NULL once unmapped), and the mapped elements
+    void *base;
+    size_t len;
+    void *a;
+    // type of da if it is not one of the default types
+    char t[D_MMAP__T_SIZ];
+};
+typedef struct d_mmap d_mmap;
+
+// d_mmap allocator callbacks; ctx is the d_mmap *. the mapped elements are never
+// resized in place: they are copied to the heap and the file is unmapped. everything
+// else is an ordinary heap block.
+static void *d_mmap__alloc_f(void *ctx, size_t n) {
+    return malloc(n);
+}
+static void *d_mmap__realloc_f(void *ctx, void *p, size_t o_n, size_t n) {
+    d_mmap *m = (d_mmap *) ctx;
+    void *q;
+    if (p == NULL || p != m->a || m->base == NULL) {
+	return realloc(p, n);
+    }
+    q = malloc(n);
+    if (q == NULL) {
+	return NULL;
+    }
+    memcpy(q, p, (o_n < n) ? o_n : n);
+    munmap(m->base, m->len);
+    m->base = NULL;
+    return q;
+}
+static void d_mmap__free_f(void *ctx, void *p, size_t n) {
+    d_mmap *m = (d_mmap *) ctx;
+    // the mapped elements
+    if (p == m->a && m->base != NULL) {
+	munmap(m->base, m->len);
+	m->base = NULL;
+    }
+    // the d_array struct, which is the start of m
+    else if (p == (void *) &m->da) {
+	if (m->base != NULL) {
+	    munmap(m->base, m->len);
+	}
+	free(m);
+    }
+    else {
+	free(p);
+    }
+}
+
+// writes the elements of da and a header describing them to the file at path
+int d_array__save(d_array *da, const char *path) {
+    // if da or path is NULL, print error and exit
+    if (da == NULL || path == NULL) {
+	fprintf(stderr, "%s: cannot save null d_array or to null path\n", D_ARRAY__SAVE_N);
+	exit(1);
+    }
+    // if da is a pointer type, print error and exit
+    if (*(da->t__ + strlen(da->t__) - 1) == '*') {
+	fprintf(stderr, "%s: cannot save d_array at %p of pointer type %s\n",
+		D_ARRAY__SAVE_N, da, da->t__);
+	exit(1);
+    }
+    // if the type of da does not fit in the header, print error and exit
+    if (strlen(da->t__) >= D_MMAP__T_SIZ) {
+	fprintf(stderr, "%s: type %s of d_array at %p is longer than %d chars\n",
+		D_ARRAY__SAVE_N, da->t__, da, D_MMAP__T_SIZ - 1);
+	exit(1);
+    }
+    d_mmap_hdr h;
+    FILE *f;
+    int ok;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, D_MMAP__MAGIC, sizeof(h.magic));
+    h.bom = 0x01020304u;
+    h.e_siz = da->e_siz;
+    h.siz = da->siz;
+    strcpy(h.t, da->t__);
+    f = fopen(path, "wb");
+    if (f == NULL) {
+	return -1;
+    }
+    ok = (fwrite(&h, sizeof(h), 1, f) == 1 &&
+	  fwrite(da->a, da->e_siz, da->siz, f) == da->siz);
+    // fclose flushes, so it can fail too
+    if (fclose(f) != 0) {
+	ok = 0;
+    }
+    return ok ? 0 : -1;
+}
+
+// returns a new d_array with the elements saved in the file at path, memory-mapped
+d_array *d_array__open_mmap(const char *path, int flags) {
+    // if path is NULL or flags is unknown, print error and exit
+    if (path == NULL || (flags != D_ARRAY__MMAP_RDONLY && flags != D_ARRAY__MMAP_COW)) {
+	fprintf(stderr, "%s: null path or unknown flags %d\n", D_ARRAY__OPEN_MMAP_N, flags);
+	exit(1);
+    }
+    int fd, e;
+    struct stat st;
+    d_mmap_hdr *h;
+    d_mmap *m;
+    size_t siz, e_siz;
+    void *base;
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+	return NULL;
+    }
+    if (fstat(fd, &st) != 0) {
+	e = errno;
+	close(fd);
+	errno = e;
+	return NULL;
+    }
+    // too short to be a d_array file
+    if ((size_t) st.st_size < D_MMAP__HDR_SIZ) {
+	close(fd);
+	errno = EINVAL;
+	return NULL;
+    }
+    // the mapping stays valid after the file is closed
+    if (flags == D_ARRAY__MMAP_COW) {
+	base = mmap(NULL, (size_t) st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    }
+    else {
+	base = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    e = errno;
+    close(fd);
+    if (base == MAP_FAILED) {
+	errno = e;
+	return NULL;
+    }
+    h = (d_mmap_hdr *) base;
+    siz = (size_t) h->siz;
+    e_siz = (size_t) h->e_siz;
+    // check the header, and that the file holds all the elements it claims to
+    if (memcmp(h->magic, D_MMAP__MAGIC, sizeof(h->magic)) != 0 || h->bom != 0x01020304u ||
+	e_siz < 1 || h->t[D_MMAP__T_SIZ - 1] != '\0' ||
+	siz > ((size_t) st.st_size - D_MMAP__HDR_SIZ) / e_siz) {
+	munmap(base, (size_t) st.st_size);
+	errno = EINVAL;
+	return NULL;
+    }
+    m = (d_mmap *) malloc(sizeof(d_mmap));
+    // if m is NULL, print error and exit
+    if (m == NULL) {
+	fprintf(stderr, "%s: malloc error when allocating d_array\n", D_ARRAY__OPEN_MMAP_N);
+	exit(2);
+    }
+    m->base = base;
+    m->len = (size_t) st.st_size;
+    m->a = (char *) base + D_MMAP__HDR_SIZ;
+    strcpy(m->t, h->t);
+    // the default types get their usual format, other types none
+    if (strcmp(m->t, __DATYPE__INT) == 0 && e_siz == sizeof(int)) {
+	m->da = d_array__view(m->a, siz, siz, D_ARRAY__INT);
+    }
+    else if (strcmp(m->t, __DATYPE__CHAR) == 0 && e_siz == sizeof(char)) {
+	m->da = d_array__view(m->a, siz, siz, D_ARRAY__CHAR);
+    }
+    else if (strcmp(m->t, __DATYPE__LONG) == 0 && e_siz == sizeof(long)) {
+	m->da = d_array__view(m->a, siz, siz, D_ARRAY__LONG);
+    }
+    else if (strcmp(m->t, __DATYPE__DOUBLE) == 0 && e_siz == sizeof(double)) {
+	m->da = d_array__view(m->a, siz, siz, D_ARRAY__DOUBLE);
+    }
+    else {
+	m->da = d_array__view(m->a, siz, siz, e_siz, NULL, m->t, '\0', '\0', '\0');
+    }
+    m->al.alloc_f = d_mmap__alloc_f;
+    m->al.realloc_f = d_mmap__realloc_f;
+    m->al.free_f = d_mmap__free_f;
+    m->al.ctx = (void *) m;
+    m->da.__al = &m->al;
+    return &m->da;
+}
@@ -0,0 +1,94 @@
+/**
+ * d_mmap.h
+ *
+ * binary files for d_arrays, and d_arrays whose elements are memory-mapped from such
+ * a file. d_array__save writes a d_array as a 64 byte header (magic number, byte order
+ * mark, element size, no. elements, and the type t__ of the d_array) followed by the
+ * raw bytes of the elements. d_array__open_mmap maps such a file into memory and
+ * returns a d_array whose elements are the mapped bytes, so opening a file does not
+ * read, parse, or copy any elements; pages are read from disk (or the page cache) as
+ * they are first touched, and the time to open a file does not depend on its size.
+ *
+ * the d_array returned by d_array__open_mmap is an ordinary d_array with an allocator
+ * of its own. its capacity is its size, so the first append or insert moves the
+ * elements to the heap (with one copy), after which it behaves like any other
+ * d_array. with D_ARRAY__MMAP_COW, elements can also be changed in place: changed pages
+ * are copied privately by the kernel and the file is never modified. with
+ * D_ARRAY__MMAP_RDONLY, the mapping is read-only, so any write to the elements that
+ * does not first resize the d_array (d_array__set, d_array__remove, d_array__sort, ...)
+ * crashes the program; use it for arrays that are only read.
+ *
+ * files are not portable between machines with different byte orders or element
+ * sizes; d_array__open_mmap refuses files with a different byte order.
+ *
+ * header file that contains declarations for functions and macros.
+ *
+ * sample usage:
+ *
+ * d_array *da;
+ * // ...build da, then...
+ * if (d_array__save(da, "da.bin") != 0) {
+ *     perror("da.bin");
+ * }
+ * d_array__free(da);
+ * // later, possibly in another process
+ * da = d_array__open_mmap("da.bin", D_ARRAY__MMAP_RDONLY);
+ * if (da == NULL) {
+ *     perror("da.bin");
+ * }
+ * // ...read da->a...
+ * d_array__free(da);
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#ifndef D_MMAP_H
+#define D_MMAP_H
+// for d_array
+#include "d_array.h"
+// user function names
+#define D_ARRAY__SAVE_N "d_array__save"
+#define D_ARRAY__OPEN_MMAP_N "d_array__open_mmap"
+// magic number at the start of every d_array file (8 chars, no null-terminating char)
+#define D_MMAP__MAGIC "D_ARRAY1"
+// size of the file header, which is also the offset of the elements in the file
+#define D_MMAP__HDR_SIZ 64
+// longest type t__ (including the null-terminating char) that can be saved
+#define D_MMAP__T_SIZ 32
+// flags for d_array__open_mmap: map the elements read-only, or copy-on-write
+#define D_ARRAY__MMAP_RDONLY 0
+#define D_ARRAY__MMAP_COW 1
+// header of a d_array file; the elements follow at offset D_MMAP__HDR_SIZ
+struct d_mmap_hdr {
+    // D_MMAP__MAGIC
+    char magic[8];
+    // 0x01020304 as written by the machine that saved the file
+    unsigned int bom;
+    // reserved, 0
+    unsigned int pad;
+    // element size, no. elements
+    unsigned long long e_siz, siz;
+    // type t__ of the d_array, null-terminated
+    char t[D_MMAP__T_SIZ];
+};
+typedef struct d_mmap_hdr d_mmap_hdr;
+// writes the elements of da and a header describing them to the file at path,
+// replacing the file if it exists. da may not be a pointer type (the memory pointed to
+// would not be saved), and da->t__ must be shorter than D_MMAP__T_SIZ chars. returns 0
+// on success, -1 if the file could not be written (errno tells why).
+int d_array__save(d_array *da, const char *path);
+// returns a new d_array with the elements saved in the file at path, mapped into memory
+// read-only (flags D_ARRAY__MMAP_RDONLY) or copy-on-write (D_ARRAY__MMAP_COW), without
+// reading them. the default types (int, char, long, double) get their usual
+// __tostr_el function and format; other types get none. the d_array must be freed with
+// d_array__free, which unmaps the file. returns NULL if the file could not be opened or
+// mapped or is not a d_array file saved on a machine with the same byte order (errno
+// tells why).
+d_array *d_array__open_mmap(const char *path, int flags);
+
+#endif /* D_MMAP_H */
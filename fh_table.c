@@ -0,0 +1,305 @@
+/**
+ * fh_table.c
+ *
+ * frozen, read-only snapshot of a string hash table from strh_table.h. see fh_table.h
+ * for how the minimal perfect hash is built and how the buffer is laid out.
+ *
+ * source file that contains function definitions.
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "fh_table.h"
+
+// byte order mark of the header
+#define FH_BOM 0x01020304u
+// no. displacements tried for a bucket before giving up
+#define FH_MAX_D (1 << 24)
+// rounds n up to a multiple of 8
+#define FH_ROUND8(n) (((n) + 7) / 8 * 8)
+// offsets of the slots and the strings in the buffer of a table of n strings
+#define FH_SLOT_OFF(n) FH_ROUND8(sizeof(fh_hdr) + (n) * sizeof(int32_t))
+#define FH_STR_OFF(n) (FH_SLOT_OFF(n) + (n) * sizeof(fh_slot))
+
+// a distinct string of the table being frozen, and the slot it gets
+struct fh_key {
+    uint64_t h;
+    char *s;
+    uint32_t len;
+    int cnt;
+    size_t slot;
+};
+
+// slot in a table of n slots of hash h with displacement d
+static inline size_t fh_mix(uint64_t h, uint64_t d, size_t n) {
+    return (size_t) (h_mix64(h + d * 0x9e3779b97f4a7c15ULL) % n);
+}
+
+// orders fh_keys by hash, then by string
+static int fh_key_cmp(const void *a, const void *b) {
+    const struct fh_key *x = (const struct fh_key *) a;
+    const struct fh_key *y = (const struct fh_key *) b;
+    if (x->h != y->h) { return (x->h < y->h) ? -1 : 1; }
+    return strcmp(x->s, y->s);
+}
+
+// points the members of ft to the parts of the siz byte buffer buf
+static void fh_table_init(fh_table *ft, void *buf, size_t siz, int mapped) {
+    fh_hdr *hdr = (fh_hdr *) buf;
+    ft->buf = buf;
+    ft->siz = siz;
+    ft->mapped = mapped;
+    ft->n = (size_t) hdr->n;
+    ft->disp = (int32_t *) ((char *) buf + sizeof(fh_hdr));
+    ft->slots = (fh_slot *) ((char *) buf + FH_SLOT_OFF(ft->n));
+    ft->str = (char *) buf + FH_STR_OFF(ft->n);
+    ft->str_siz = siz - FH_STR_OFF(ft->n);
+}
+
+// returns a frozen copy of ht
+fh_table *h_table_freeze(h_table *ht) {
+    assert(ht != NULL);
+    struct fh_key *k;
+    // no. nodes, no. distinct strings, loop indices, bytes of strings
+    size_t n_k, n, i, j, b, str_siz;
+    ht_node *hp;
+    // the nodes are all in ht->table after this
+    h_table_rehash(ht);
+    // gather the nodes, hashed with h_fnv1a
+    k = (struct fh_key *) malloc((ht->n + 1) * sizeof(struct fh_key));
+    assert(k != NULL);
+    n_k = 0;
+    for (i = 0; i < (size_t) ht->siz; i++) {
+        for (hp = *(ht->table + i); hp != NULL; hp = hp->next) {
+            k[n_k].s = hp->str;
+            k[n_k].len = HT_STR_LEN(hp->str);
+            k[n_k].h = (ht->hf == h_fnv1a) ? hp->h : h_fnv1a(hp->str, k[n_k].len);
+            k[n_k++].cnt = hp->cnt;
+        }
+    }
+    // sort so that the nodes of the same string are next to each other, and merge them
+    qsort(k, n_k, sizeof(struct fh_key), fh_key_cmp);
+    n = 0;
+    for (i = 0; i < n_k; i++) {
+        if (n > 0 && k[n - 1].h == k[i].h && strcmp(k[n - 1].s, k[i].s) == 0) {
+            k[n - 1].cnt += k[i].cnt;
+        }
+        // distinct strings with the same hash always get the same slot
+        else if (n > 0 && k[n - 1].h == k[i].h) {
+            free(k);
+            errno = EINVAL;
+            return NULL;
+        }
+        else {
+            k[n++] = k[i];
+        }
+    }
+    assert(n <= INT32_MAX);
+    // bucket b holds the strings with hash % n == b; b_st[b] is the index in b_k of
+    // the first string of bucket b, and b_siz[b] is its no. strings. b_ord holds the
+    // buckets from biggest to smallest, and s_st[s] is the index in b_ord of the first
+    // bucket with s strings
+    size_t *b_st = (size_t *) calloc(n + 2, sizeof(size_t));
+    size_t *b_k = (size_t *) malloc((n + 1) * sizeof(size_t));
+    size_t *b_ord = (size_t *) malloc((n + 1) * sizeof(size_t));
+    size_t *b_siz = (size_t *) calloc(n + 1, sizeof(size_t));
+    size_t *s_st = (size_t *) calloc(n + 2, sizeof(size_t));
+    char *taken = (char *) calloc(n + 1, 1);
+    assert(b_st != NULL && b_k != NULL && b_ord != NULL && b_siz != NULL);
+    assert(s_st != NULL && taken != NULL);
+    for (i = 0; i < n; i++) {
+        b_siz[k[i].h % n]++;
+    }
+    for (b = 0; b < n; b++) {
+        b_st[b + 1] = b_st[b] + b_siz[b];
+        s_st[b_siz[b]]++;
+    }
+    for (i = 0; i < n; i++) {
+        b = k[i].h % n;
+        b_k[b_st[b] + --b_siz[b]] = i;
+    }
+    // counting sort of the buckets by decreasing size
+    for (i = n + 1, j = 0; i-- > 0; ) {
+        j += s_st[i];
+        s_st[i] = j - s_st[i];
+    }
+    for (b = 0; b < n; b++) {
+        b_siz[b] = b_st[b + 1] - b_st[b];
+        b_ord[s_st[b_siz[b]]++] = b;
+    }
+    // the buffer; the strings go after the slots
+    str_siz = 0;
+    for (i = 0; i < n; i++) {
+        str_siz += k[i].len + 1;
+    }
+    size_t siz = FH_STR_OFF(n) + str_siz;
+    void *buf = calloc(siz, 1);
+    assert(buf != NULL);
+    fh_table *ft = (fh_table *) malloc(sizeof(fh_table));
+    assert(ft != NULL);
+    fh_hdr *hdr = (fh_hdr *) buf;
+    memcpy(hdr->magic, FH_MAGIC, sizeof(hdr->magic));
+    hdr->bom = FH_BOM;
+    hdr->n = n;
+    hdr->siz = siz;
+    fh_table_init(ft, buf, siz, 0);
+    // find a displacement for each bucket of more than one string, biggest first
+    size_t o = 0;
+    for (o = 0; o < n && b_siz[b_ord[o]] > 1; o++) {
+        b = b_ord[o];
+        uint64_t d;
+        for (d = 1; d < FH_MAX_D; d++) {
+            // try to place each string of the bucket in a free slot
+            for (i = b_st[b]; i < b_st[b + 1]; i++) {
+                k[b_k[i]].slot = fh_mix(k[b_k[i]].h, d, n);
+                if (taken[k[b_k[i]].slot]) { break; }
+                taken[k[b_k[i]].slot] = 1;
+            }
+            if (i == b_st[b + 1]) { break; }
+            // free the slots taken by this try
+            for (j = b_st[b]; j < i; j++) {
+                taken[k[b_k[j]].slot] = 0;
+            }
+        }
+        // a bucket that cannot be placed means two strings that always collide
+        if (d == FH_MAX_D) {
+            free_fh_table(ft);
+            ft = NULL;
+            errno = EINVAL;
+            break;
+        }
+        ft->disp[b] = (int32_t) d;
+    }
+    // give each bucket of one string a free slot
+    for (j = 0; ft != NULL && o < n && b_siz[b_ord[o]] == 1; o++) {
+        b = b_ord[o];
+        while (taken[j]) { j++; }
+        taken[j] = 1;
+        k[b_k[b_st[b]]].slot = j;
+        ft->disp[b] = -(int32_t) j - 1;
+    }
+    // fill in the slots and strings
+    for (i = 0, j = 0; ft != NULL && i < n; i++) {
+        fh_slot *sl = ft->slots + k[i].slot;
+        sl->h = k[i].h;
+        sl->off = j;
+        sl->len = k[i].len;
+        sl->cnt = k[i].cnt;
+        memcpy(ft->str + j, k[i].s, k[i].len + 1);
+        j += k[i].len + 1;
+    }
+    free(b_st);
+    free(b_k);
+    free(b_ord);
+    free(b_siz);
+    free(s_st);
+    free(taken);
+    free(k);
+    return ft;
+}
+// search for a string in the table; returns occurrences of s in the table
+int fh_table_nsearch(fh_table *ft, char *s) {
+    size_t n = strlen(s);
+    assert(ft != NULL && n > 0);
+    if (ft->n == 0) { return 0; }
+    uint64_t h = h_fnv1a(s, n);
+    int32_t d = ft->disp[h % ft->n];
+    size_t i = (d < 0) ? (size_t) (-(int64_t) d - 1) : fh_mix(h, (uint64_t) d, ft->n);
+    // the bounds checks guard against a damaged file
+    if (i >= ft->n) { return 0; }
+    fh_slot *sl = ft->slots + i;
+    if (sl->h != h || sl->len != n || sl->off >= ft->str_siz ||
+        n >= ft->str_siz - sl->off || memcmp(ft->str + sl->off, s, n) != 0) {
+        return 0;
+    }
+    return sl->cnt;
+}
+// writes the buffer of ft to the file at path
+int fh_table_save(fh_table *ft, const char *path) {
+    assert(ft != NULL && path != NULL);
+    FILE *f;
+    int ok;
+    f = fopen(path, "wb");
+    if (f == NULL) {
+        return -1;
+    }
+    ok = (fwrite(ft->buf, 1, ft->siz, f) == ft->siz);
+    // fclose flushes, so it can fail too
+    if (fclose(f) != 0) {
+        ok = 0;
+    }
+    return ok ? 0 : -1;
+}
+// returns a new fh_table whose buffer is the file at path, mapped read-only
+fh_table *fh_table_open(const char *path) {
+    assert(path != NULL);
+    int fd, e;
+    struct stat st;
+    fh_hdr *hdr;
+    fh_table *ft;
+    size_t siz, n;
+    void *buf;
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    if (fstat(fd, &st) != 0) {
+        e = errno;
+        close(fd);
+        errno = e;
+        return NULL;
+    }
+    siz = (size_t) st.st_size;
+    // too short to be an fh_table file
+    if (siz < sizeof(fh_hdr)) {
+        close(fd);
+        errno = EINVAL;
+        return NULL;
+    }
+    // the mapping stays valid after the file is closed
+    buf = mmap(NULL, siz, PROT_READ, MAP_SHARED, fd, 0);
+    e = errno;
+    close(fd);
+    if (buf == MAP_FAILED) {
+        errno = e;
+        return NULL;
+    }
+    hdr = (fh_hdr *) buf;
+    n = (size_t) hdr->n;
+    // check the header, and that the file holds the displacements and slots it claims
+    if (memcmp(hdr->magic, FH_MAGIC, sizeof(hdr->magic)) != 0 || hdr->bom != FH_BOM ||
+        hdr->siz != siz || n > INT32_MAX || FH_STR_OFF(n) > siz) {
+        munmap(buf, siz);
+        errno = EINVAL;
+        return NULL;
+    }
+    ft = (fh_table *) malloc(sizeof(fh_table));
+    assert(ft != NULL);
+    fh_table_init(ft, buf, siz, 1);
+    return ft;
+}
+// free a table, unmapping its file if it was opened with fh_table_open
+void free_fh_table(fh_table *ft) {
+    assert(ft != NULL);
+    if (ft->mapped) {
+        munmap(ft->buf, ft->siz);
+    }
+    else {
+        free(ft->buf);
+    }
+    free(ft);
+}
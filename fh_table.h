@@ -0,0 +1,118 @@
+/**
+ * fh_table.h
+ *
+ * frozen, read-only snapshot of a string hash table from strh_table.h, for tables
+ * that are only searched once they are built (ex. the queries of strsea.c).
+ * h_table_freeze turns an h_table into an fh_table: a minimal perfect hash of the
+ * distinct strings of the table, in the "hash, displace, and compress" style, stored
+ * with the strings and their counts in one flat buffer that has no pointers in it.
+ *
+ * the n distinct strings go into n buckets by hash. going from the biggest bucket to
+ * the smallest, each bucket with more than one string gets a displacement d > 0 such
+ * that mixing each string's hash with d sends all of its strings to distinct slots
+ * that are still free. buckets of one string are then simply given one of the free
+ * slots, which is stored as a negative displacement. so every string has its own slot
+ * in [0, n), and a search hashes the string, reads the displacement of its bucket,
+ * computes its slot, and compares the string with the one in the slot: at most one
+ * string comparison, and usually 3 cache misses (displacement, slot, string bytes).
+ *
+ * the buffer is laid out as: a 32 byte header (magic number, byte order mark, no.
+ * strings, size of the buffer), n int32_t displacements, n slots (hash, offset and
+ * length of the string, and count), then the strings with their '\0'. fh_table_save
+ * writes the buffer to a file as is, and fh_table_open maps such a file into memory,
+ * so opening a frozen table does not read or parse anything, and its pages are read
+ * from disk as searches touch them. strings are always hashed with h_fnv1a, whatever
+ * the hash function of the h_table, so that any program can search a saved table.
+ * files are not portable between machines with different byte orders.
+ *
+ * header file that contains declarations for functions, macros, and the structs.
+ *
+ * sample usage:
+ *
+ * fh_table *ft;
+ * // ...build h_table *ht, then...
+ * ft = h_table_freeze(ht);
+ * if (fh_table_save(ft, "ht.bin") != 0) {
+ *     perror("ht.bin");
+ * }
+ * free_fh_table(ft);
+ * // later, possibly in another process
+ * ft = fh_table_open("ht.bin");
+ * if (ft == NULL) {
+ *     perror("ht.bin");
+ * }
+ * printf("%d\n", fh_table_nsearch(ft, "abc"));
+ * free_fh_table(ft);
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#ifndef FH_TABLE_H
+#define FH_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+// for h_table
+#include "strh_table.h"
+
+// magic number at the start of every fh_table buffer (8 chars, no '\0')
+#define FH_MAGIC "FH_TABL1"
+// header of an fh_table buffer
+struct fh_hdr {
+    char magic[8];
+    // 0x01020304, to detect buffers written on a machine with a different byte order
+    uint32_t bom;
+    uint32_t pad;
+    // no. distinct strings, size of the whole buffer in bytes
+    uint64_t n, siz;
+};
+typedef struct fh_hdr fh_hdr;
+// slot of an fh_table
+struct fh_slot {
+    // h_fnv1a hash of the string
+    uint64_t h;
+    // offset of the string from the start of the strings, length of the string
+    uint64_t off;
+    uint32_t len;
+    // no. times the string was inserted
+    int32_t cnt;
+};
+typedef struct fh_slot fh_slot;
+// frozen string hash table
+struct fh_table {
+    // the buffer and its size; mapped is nonzero if buf is mapped from a file
+    void *buf;
+    size_t siz;
+    int mapped;
+    // no. distinct strings, and the parts of buf
+    size_t n;
+    int32_t *disp;
+    fh_slot *slots;
+    char *str;
+    // no. bytes of strings
+    size_t str_siz;
+};
+typedef struct fh_table fh_table;
+// returns a frozen copy of ht, which is not changed except for finishing any rehash
+// in progress. the count of each distinct string is the same as h_table_nsearch
+// gives. returns NULL and sets errno to EINVAL in the (astronomically unlikely) case
+// that two distinct strings have the same 64-bit h_fnv1a hash
+fh_table *h_table_freeze(h_table *ht);
+// search for a string in the table; returns occurrences of s in the table
+int fh_table_nsearch(fh_table *ft, char *s);
+// writes the buffer of ft to the file at path. returns 0 on success, or -1 with errno
+// set if the file could not be written
+int fh_table_save(fh_table *ft, const char *path);
+// returns a new fh_table whose buffer is the file at path, mapped read-only. returns
+// NULL with errno set if the file could not be opened or mapped, or to EINVAL if it is
+// not an fh_table file of this machine's byte order
+fh_table *fh_table_open(const char *path);
+// free a table, unmapping its file if it was opened with fh_table_open
+void free_fh_table(fh_table *ft);
+
+#endif /* FH_TABLE_H */
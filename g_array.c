@@ -0,0 +1,315 @@
+/**
+ * g_array.c
+ *
+ * gap buffer version of the d_array. a g_array holds the same kind of elements as a
+ * d_array (element size e_siz, __tostr_el function, type t__, and separator/pre/post
+ * chars, so the D_ARRAY__* type macros work with g_array__new), but its memory has a
+ * gap of unused elements in it that sits at a cursor. inserts and removes at the
+ * cursor only move the end of the gap, so they are O(1) amortized, and moving the
+ * cursor by k elements costs k element moves.
+ *
+ * source file that contains function definitions.
+ *
+ * sample usage:
+ *
+ * int i;
+ * char *s;
+ * g_array *ga;
+ * ga = g_array__new(AUTO_SIZ, D_ARRAY__INT);
+ * for (i = 0; i < 10; i++) {
+ *     g_array__insert(ga, &i, 0);
+ * }
+ * s = g_array__tostr(ALL__(ga));
+ * printf("%s\n", s);
+ * free(s);
+ * g_array__free(ga);
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "g_array.h"
+// for d_array__view
+#include "d_array_t.h"
+
+// returns nonzero if ga is a pointer type (its elements own memory)
+#define G_ARRAY__IS_PTR(ga) (*((ga)->t__ + strlen((ga)->t__) - 1) == '*')
+
+// resizes ga->a to hold n_max >= ga->siz elements, keeping the gap at the cursor. the
+// elements after the gap are moved so that they still end at the end of ga->a.
+static void g_array__resize(g_array *ga, size_t n_max, const char *fn) {
+    // no. elements after the gap, size of element
+    size_t t_n, e_siz;
+    e_siz = ga->e_siz;
+    t_n = ga->max_siz - ga->g_e;
+    // when shrinking, move the elements after the gap down before the realloc
+    if (n_max < ga->max_siz) {
+	memmove((char *) ga->a + (n_max - t_n) * e_siz, (char *) ga->a + ga->g_e * e_siz,
+		t_n * e_siz);
+    }
+    void *a = realloc(ga->a, n_max * e_siz);
+    // if a is NULL, print error and exit
+    if (a == NULL) {
+	fprintf(stderr, "%s: realloc failure resizing g_array at %p\n", fn, ga);
+	exit(2);
+    }
+    ga->a = a;
+    // when growing, move the elements after the gap up after the realloc
+    if (n_max > ga->max_siz) {
+	memmove((char *) ga->a + (n_max - t_n) * e_siz, (char *) ga->a + ga->g_e * e_siz,
+		t_n * e_siz);
+    }
+    ga->g_e = n_max - t_n;
+    ga->max_siz = n_max;
+}
+
+// creates a new g_array with the same arguments as d_array__new, ex. a g_array of int
+// that can hold DEFAULT_SIZ elements before resizing is g_array__new(DEFAULT_SIZ,
+// D_ARRAY__INT). the cursor starts at index 0.
+g_array *g_array__new(size_t n, size_t e, char *(*__tef)(const void *), const char *__t,
+		      char __sep, char __pr_c, char __ps_c) {
+    // if n < 1, print error and exit
+    if (n < 1) {
+	fprintf(stderr,
+		"%s: number of starting elements must be positive\n", G_ARRAY__NEW_N);
+	exit(1);
+    }
+    // if e < 1, print error and exit
+    if (e < 1) {
+	fprintf(stderr, "%s: size of element must be positive\n", G_ARRAY__NEW_N);
+	exit(1);
+    }
+    // if __t is NULL, print error and exit
+    if (__t == NULL) {
+	fprintf(stderr, "%s: cannot pass NULL as a type\n", G_ARRAY__NEW_N);
+	exit(1);
+    }
+    // create new g_array struct
+    g_array *ga = (g_array *) malloc(sizeof(g_array));
+    // if ga is NULL, print error and exit
+    if (ga == NULL) {
+	fprintf(stderr, "%s: malloc error when allocating g_array\n", G_ARRAY__NEW_N);
+	exit(2);
+    }
+    ga->a = malloc(n * e);
+    // if a is NULL, print error and exit
+    if (ga->a == NULL) {
+	fprintf(stderr, "%s: malloc error when allocating memory at %p->a\n",
+		G_ARRAY__NEW_N, ga);
+	exit(2);
+    }
+    ga->siz = 0;
+    ga->e_siz = e;
+    ga->max_siz = n;
+    // the whole array is gap
+    ga->g_s = 0;
+    ga->g_e = n;
+    ga->__tostr_el = __tef;
+    ga->t__ = (char *) __t;
+    ga->__sep = __sep;
+    ga->__pr_c = __pr_c;
+    ga->__ps_c = __ps_c;
+    return ga;
+}
+
+// moves the cursor of ga to index i, where i <= ga->siz, by moving |i - ga->g_s|
+// elements across the gap. i == ga->siz puts the gap at the end, making the g_array
+// contiguous like a d_array.
+void g_array__move(g_array *ga, size_t i) {
+    // if ga is NULL, print error and exit
+    if (ga == NULL) {
+	fprintf(stderr, "%s: cannot move cursor of null g_array\n", G_ARRAY__MOVE_N);
+	exit(1);
+    }
+    // if i > ga->siz, print error and exit
+    if (i > ga->siz) {
+	fprintf(stderr, "%s: cannot move cursor outside of defined array bounds of "
+		"g_array at %p\n", G_ARRAY__MOVE_N, ga);
+	exit(1);
+    }
+    char *ca = (char *) ga->a;
+    size_t e_siz = ga->e_siz;
+    // cursor moves left: elements i to g_s - 1 go to the end of the gap
+    if (i < ga->g_s) {
+	size_t k = ga->g_s - i;
+	memmove(ca + (ga->g_e - k) * e_siz, ca + i * e_siz, k * e_siz);
+	ga->g_s -= k;
+	ga->g_e -= k;
+    }
+    // cursor moves right: the first i - g_s elements after the gap go to its start
+    else if (i > ga->g_s) {
+	size_t k = i - ga->g_s;
+	memmove(ca + ga->g_s * e_siz, ca + ga->g_e * e_siz, k * e_siz);
+	ga->g_s += k;
+	ga->g_e += k;
+    }
+}
+
+// writes ga->e_siz bytes from e into ga at index i, where i <= ga->siz, and leaves the
+// cursor right after the new element, so that a run of inserts at increasing indices
+// (typing) does not move any elements, and a run of inserts at index 0 (prepending)
+// moves one element per insert, so each insert takes O(1) time.
+void g_array__insert(g_array *ga, void *e, size_t i) {
+    // if ga is NULL, print error and exit
+    if (ga == NULL) {
+	fprintf(stderr, "%s: cannot insert element into null g_array\n",
+		G_ARRAY__INSERT_N);
+	exit(1);
+    }
+    // if e is NULL, print error and exit
+    if (e == NULL) {
+	fprintf(stderr, "%s: cannot insert null element into g_array at %p\n",
+		G_ARRAY__INSERT_N, ga);
+	exit(1);
+    }
+    // if i > ga->siz, print error and exit
+    if (i > ga->siz) {
+	fprintf(stderr,
+		"%s: cannot insert outside of defined array bounds of g_array at %p\n",
+		G_ARRAY__INSERT_N, ga);
+	exit(1);
+    }
+    // move the gap to i, and double the capacity if the gap is empty. when prepending,
+    // the cursor is at 1 after the previous insert, so this moves only one element
+    g_array__move(ga, i);
+    if (ga->g_s == ga->g_e) {
+	g_array__resize(ga, 2 * ga->max_siz, G_ARRAY__INSERT_N);
+    }
+    memcpy((char *) ga->a + ga->g_s * ga->e_siz, e, ga->e_siz);
+    ga->g_s++;
+    ga->siz++;
+}
+
+// appends an element to ga, moving the cursor to the end of ga
+void g_array__append(g_array *ga, void *e) {
+    // if ga is NULL, print error and exit
+    if (ga == NULL) {
+	fprintf(stderr, "%s: cannot append element onto null g_array\n",
+		G_ARRAY__APPEND_N);
+	exit(1);
+    }
+    g_array__insert(ga, e, ga->siz);
+}
+
+// removes the element at index i, where i < ga->siz. removing the element right before
+// or right at the cursor only widens the gap; otherwise the cursor is moved to i first.
+// the capacity of ga is halved when ga->siz <= ga->max_siz / 4. if the g_array is a
+// pointer type, the memory pointed to by the element is freed.
+void g_array__remove(g_array *ga, size_t i) {
+    // if ga is NULL, print error and exit
+    if (ga == NULL) {
+	fprintf(stderr, "%s: cannot remove element from null g_array\n",
+		G_ARRAY__REMOVE_N);
+	exit(1);
+    }
+    // if i >= ga->siz (includes ga->siz == 0), print error and exit
+    if (i >= ga->siz) {
+	fprintf(stderr, "%s: cannot remove element from outside defined array bounds of "
+		"g_array at %p\n", G_ARRAY__REMOVE_N, ga);
+	exit(1);
+    }
+    // if the g_array is a pointer type, free the underlying memory for the element i
+    if (G_ARRAY__IS_PTR(ga)) {
+	free(*((void **) g_array__get(ga, i)));
+    }
+    // element right before the cursor: the gap grows left ("backspace")
+    if (i + 1 == ga->g_s) {
+	ga->g_s--;
+    }
+    // else move the cursor to i if needed; the gap then grows right ("delete")
+    else {
+	g_array__move(ga, i);
+	ga->g_e++;
+    }
+    ga->siz--;
+    // if ga->siz <= ga->max_siz / 4, halve array size (never below 1 element)
+    if (ga->max_siz > 1 && ga->siz <= ga->max_siz / 4) {
+	g_array__resize(ga, ga->max_siz / 2, G_ARRAY__REMOVE_N);
+    }
+}
+
+// returns a void * to the element in g_array ga located at index i
+void *g_array__get(g_array *ga, size_t i) {
+    // if ga is NULL, print error and exit
+    if (ga == NULL) {
+	fprintf(stderr, "%s: cannot return void * to element %lu of null g_array\n",
+		G_ARRAY__GET_N, (unsigned long) i);
+	exit(1);
+    }
+    // if i >= ga->siz, print error and exit
+    if (i >= ga->siz) {
+	fprintf(stderr,
+		"%s: cannot retrieve data outside of defined bounds of g_array at %p\n",
+		G_ARRAY__GET_N, ga);
+	exit(1);
+    }
+    // elements at and after the cursor are after the gap
+    if (i >= ga->g_s) {
+	i += ga->g_e - ga->g_s;
+    }
+    return (void *) ((char *) ga->a + i * ga->e_siz);
+}
+
+// writes the ith element of ga to the address at p
+void g_array__getcpy(void *p, g_array *ga, size_t i) {
+    // if p is NULL, print error and exit
+    if (p == NULL) {
+	fprintf(stderr, "%s: cannot write to null address from g_array at %p\n",
+		G_ARRAY__GETCPY_N, ga);
+	exit(1);
+    }
+    memcpy(p, g_array__get(ga, i), ga->e_siz);
+}
+
+// overwrites the ith element of ga with ga->e_siz bytes from p
+void g_array__set(g_array *ga, size_t i, void *p) {
+    // if p is NULL, print error and exit
+    if (p == NULL) {
+	fprintf(stderr, "%s: cannot write from null address to g_array at %p\n",
+		G_ARRAY__SET_N, ga);
+	exit(1);
+    }
+    memcpy(g_array__get(ga, i), p, ga->e_siz);
+}
+
+// same as d_array__tostr, including ALL__(ga) for all elements. moves the gap to the
+// end of ga first, so that the elements are contiguous.
+char *g_array__tostr(g_array *ga, size_t si, size_t ei) {
+    // if ga is NULL, print error and exit
+    if (ga == NULL) {
+	fprintf(stderr, "%s: cannot convert null g_array to string\n", G_ARRAY__TOSTR_N);
+	exit(1);
+    }
+    // d_array with the same memory and format as ga, once the gap is at the end
+    g_array__move(ga, ga->siz);
+    d_array da = d_array__view(ga->a, ga->siz, ga->max_siz, ga->e_siz, ga->__tostr_el,
+			       ga->t__, ga->__sep, ga->__pr_c, ga->__ps_c);
+    return d_array__tostr(&da, si, ei);
+}
+
+// frees a g_array, along with the memory pointed to by each element if the g_array is
+// a pointer type
+void g_array__free(g_array *ga) {
+    // if ga or ga->a is NULL, print error and exit
+    if (ga == NULL || ga->a == NULL) {
+	fprintf(stderr, "%s: cannot free null pointer\n", G_ARRAY__FREE_N);
+	exit(1);
+    }
+    // if the type of the g_array is a pointer type, free what each element points to
+    if (G_ARRAY__IS_PTR(ga)) {
+	size_t i;
+	for (i = 0; i < ga->siz; i++) {
+	    free(*((void **) g_array__get(ga, i)));
+	}
+    }
+    free(ga->a);
+    free(ga);
+}
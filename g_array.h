@@ -0,0 +1,94 @@
+/**
+ * g_array.h
+ *
+ * gap buffer version of the d_array. a g_array holds the same kind of elements as a
+ * d_array (element size e_siz, __tostr_el function, type t__, and separator/pre/post
+ * chars, so the D_ARRAY__* type macros work with g_array__new), but its memory has a
+ * gap of unused elements in it that sits at a cursor. inserts and removes at the
+ * cursor only move the end of the gap, so they are O(1) amortized, and moving the
+ * cursor by k elements costs k element moves. a d_array on the other hand always
+ * moves its entire tail. this makes the g_array good for text editor style edits that
+ * happen near each other, and for inserting and removing at the front of large
+ * arrays, where the cursor can simply stay. index access is one comparison more than
+ * for a d_array.
+ *
+ * header file that contains declarations for functions, macros, and the struct.
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#ifndef G_ARRAY_H
+#define G_ARRAY_H
+// include stddef.h for size_t
+#include <stddef.h>
+// for D_ARRAY__* type macros, __tostr_el__* functions, AUTO_SIZ and DEFAULT_SIZ
+#include "d_array.h"
+// user function names
+#define G_ARRAY__NEW_N "g_array__new"
+#define G_ARRAY__FREE_N "g_array__free"
+#define G_ARRAY__MOVE_N "g_array__move"
+#define G_ARRAY__INSERT_N "g_array__insert"
+#define G_ARRAY__APPEND_N "g_array__append"
+#define G_ARRAY__REMOVE_N "g_array__remove"
+#define G_ARRAY__GET_N "g_array__get"
+#define G_ARRAY__GETCPY_N "g_array__getcpy"
+#define G_ARRAY__SET_N "g_array__set"
+#define G_ARRAY__TOSTR_N "g_array__tostr"
+// struct for gap buffer
+struct g_array {
+    // point to an element (to serve as an array)
+    void *a;
+    // size of each element in the g_array, no. elements in g_array, no. elements
+    // g_array can hold (before resizing)
+    size_t e_siz, siz, max_siz;
+    // the gap is elements g_s to g_e - 1 of a. g_s is also the cursor: the index in
+    // the g_array that the next element inserted at the cursor goes to. elements 0 to
+    // g_s - 1 of the g_array are a[0] to a[g_s - 1], while elements g_s to siz - 1 are
+    // a[g_e] to a[max_siz - 1].
+    size_t g_s, g_e;
+    // same as in the d_array struct
+    char *(*__tostr_el)(const void *);
+    char *t__;
+    char __sep, __pr_c, __ps_c;
+};
+typedef struct g_array g_array;
+// creates a new g_array with the same arguments as d_array__new, ex. a g_array of int
+// that can hold DEFAULT_SIZ elements before resizing is g_array__new(DEFAULT_SIZ,
+// D_ARRAY__INT). the cursor starts at index 0.
+g_array *g_array__new(size_t n, size_t e, char *(*__tef)(const void *), const char *__t,
+		      char __sep, char __pr_c, char __ps_c);
+// moves the cursor of ga to index i, where i <= ga->siz, by moving |i - ga->g_s|
+// elements across the gap. i == ga->siz puts the gap at the end, making the g_array
+// contiguous like a d_array.
+void g_array__move(g_array *ga, size_t i);
+// writes ga->e_siz bytes from e into ga at index i, where i <= ga->siz, and leaves the
+// cursor right after the new element, so that a run of inserts at increasing indices
+// (typing) does not move any elements, and a run of inserts at index 0 (prepending)
+// moves one element per insert, so each insert takes O(1) time.
+void g_array__insert(g_array *ga, void *e, size_t i);
+// appends an element to ga, moving the cursor to the end of ga
+void g_array__append(g_array *ga, void *e);
+// removes the element at index i, where i < ga->siz. removing the element right before
+// or right at the cursor only widens the gap; otherwise the cursor is moved to i first.
+// the capacity of ga is halved when ga->siz <= ga->max_siz / 4. if the g_array is a
+// pointer type, the memory pointed to by the element is freed.
+void g_array__remove(g_array *ga, size_t i);
+// returns a void * to the element in g_array ga located at index i
+void *g_array__get(g_array *ga, size_t i);
+// writes the ith element of ga to the address at p
+void g_array__getcpy(void *p, g_array *ga, size_t i);
+// overwrites the ith element of ga with ga->e_siz bytes from p
+void g_array__set(g_array *ga, size_t i, void *p);
+// same as d_array__tostr, including ALL__(ga) for all elements. moves the gap to the
+// end of ga first, so that the elements are contiguous.
+char *g_array__tostr(g_array *ga, size_t si, size_t ei);
+// frees a g_array, along with the memory pointed to by each element if the g_array is
+// a pointer type
+void g_array__free(g_array *ga);
+
+#endif /* G_ARRAY_H */
@@ -0,0 +1,180 @@
+/**
+ * rx_tree.c
+ *
+ * radix tree (path-compressed trie) with per-node subtree counts, for exact and
+ * prefix counts of inserted strings. see rx_tree.h.
+ *
+ * source file that contains function definitions.
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rx_tree.h"
+
+// size of the child array of a node with n children, including the first chars
+#define RX_CH_SIZ(n) ((n) * (sizeof(rx_node *) + 1))
+
+// returns a new node with label lab of len chars and no children, from the arena
+static rx_node *new_rx_node(rx_tree *rt, char *lab, uint32_t len) {
+    rx_node *x = (rx_node *) d_arena__malloc(rt->ar, sizeof(rx_node));
+    x->lab = lab;
+    x->len = len;
+    x->n_ch = 0;
+    x->cnt = x->sub = 0;
+    x->ch = NULL;
+    rt->n++;
+    rt->mem += sizeof(rx_node);
+    return x;
+}
+
+// returns the child of x whose label starts with c, and sets *i to its index, or
+// returns NULL if there is none
+static inline rx_node *rx_child(rx_node *x, unsigned char c, uint32_t *i) {
+    unsigned char *p;
+    if (x->n_ch == 0) { return NULL; }
+    p = (unsigned char *) memchr(RX_FC(x), c, x->n_ch);
+    if (p == NULL) { return NULL; }
+    *i = (uint32_t) (p - RX_FC(x));
+    return x->ch[*i];
+}
+
+// adds c as the last child of x. the first chars move to make room for the new
+// pointer in front of them
+static void rx_add_child(rx_tree *rt, rx_node *x, rx_node *c) {
+    uint32_t n = x->n_ch;
+    x->ch = (rx_node **) realloc(x->ch, RX_CH_SIZ(n + 1));
+    assert(x->ch != NULL);
+    memmove(x->ch + n + 1, x->ch + n, n);
+    x->ch[n] = c;
+    x->n_ch = n + 1;
+    RX_FC(x)[n] = (unsigned char) c->lab[0];
+    rt->mem += RX_CH_SIZ(1);
+}
+
+// returns the node where the path spelled by s ends and sets *in to nonzero if s ends
+// inside the label of that node, or returns NULL if no inserted string starts with s
+static rx_node *rx_tree_walk(rx_tree *rt, const char *s, int *in) {
+    rx_node *x = rt->root, *c;
+    uint32_t i, k;
+    while (*s != '\0') {
+        c = rx_child(x, (unsigned char) *s, &i);
+        if (c == NULL) { return NULL; }
+        // labels have no '\0', so the loop also stops at the end of s
+        for (k = 1; k < c->len && s[k] == c->lab[k]; k++)
+            ;
+        if (k < c->len) {
+            *in = 1;
+            return (s[k] == '\0') ? c : NULL;
+        }
+        s += k;
+        x = c;
+    }
+    *in = 0;
+    return x;
+}
+
+// return a pointer to a new, empty radix tree
+rx_tree *new_rx_tree(void) {
+    rx_tree *rt = (rx_tree *) malloc(sizeof(rx_tree));
+    assert(rt != NULL);
+    rt->n = rt->n_d = 0;
+    rt->mem = sizeof(rx_tree);
+    rt->ar = d_arena__new(D_ARENA__BLK_SIZ);
+    rt->root = new_rx_node(rt, NULL, 0);
+    return rt;
+}
+
+// insert a string into the tree. the subtree count of every node on the path is
+// incremented on the way down. if s ends inside a label or leaves it part way, the
+// node is split at that point, and a leaf holding the rest of s is added
+void rx_tree_insert(rx_tree *rt, char *s) {
+    assert(rt != NULL && s != NULL);
+    rx_node *x = rt->root, *c, *m;
+    uint32_t i, k;
+    size_t len;
+    char *lab;
+    x->sub++;
+    while (*s != '\0') {
+        c = rx_child(x, (unsigned char) *s, &i);
+        // no child starts with *s; the rest of s becomes a new leaf
+        if (c == NULL) {
+            len = strlen(s);
+            assert(len <= UINT32_MAX);
+            lab = (char *) d_arena__malloc(rt->ar, len);
+            memcpy(lab, s, len);
+            rt->mem += len;
+            c = new_rx_node(rt, lab, (uint32_t) len);
+            rx_add_child(rt, x, c);
+            c->sub = c->cnt = 1;
+            rt->n_d++;
+            return;
+        }
+        for (k = 1; k < c->len && s[k] == c->lab[k]; k++)
+            ;
+        // split c after its first k chars; m takes c's place under x
+        if (k < c->len) {
+            m = new_rx_node(rt, c->lab, k);
+            m->sub = c->sub;
+            c->lab += k;
+            c->len -= k;
+            rx_add_child(rt, m, c);
+            x->ch[i] = m;
+            c = m;
+        }
+        c->sub++;
+        s += k;
+        x = c;
+    }
+    if (x->cnt++ == 0) { rt->n_d++; }
+}
+
+// search for a string in the tree; returns occurrences of s in the tree
+int rx_tree_nsearch(rx_tree *rt, char *s) {
+    assert(rt != NULL && s != NULL);
+    int in;
+    rx_node *x = rx_tree_walk(rt, s, &in);
+    return (x != NULL && !in) ? x->cnt : 0;
+}
+
+// returns the no. strings inserted into the tree that start with p. if p ends inside
+// a label, the strings that start with p are exactly those below that label's node
+int rx_tree_npsearch(rx_tree *rt, char *p) {
+    assert(rt != NULL && p != NULL);
+    int in;
+    rx_node *x = rx_tree_walk(rt, p, &in);
+    return (x != NULL) ? x->sub : 0;
+}
+
+// free a radix tree. the child arrays are freed with an explicit stack, since the
+// tree can be as deep as its longest string is long; the nodes and labels go with
+// the arena
+void free_rx_tree(rx_tree *rt) {
+    assert(rt != NULL);
+    rx_node **st, *x;
+    size_t n = 0, cap = 64;
+    uint32_t i;
+    st = (rx_node **) malloc(cap * sizeof(rx_node *));
+    assert(st != NULL);
+    st[n++] = rt->root;
+    while (n > 0) {
+        x = st[--n];
+        if (n + x->n_ch > cap) {
+            while (n + x->n_ch > cap) { cap *= 2; }
+            st = (rx_node **) realloc(st, cap * sizeof(rx_node *));
+            assert(st != NULL);
+        }
+        for (i = 0; i < x->n_ch; i++) { st[n++] = x->ch[i]; }
+        free(x->ch);
+    }
+    free(st);
+    d_arena__free(rt->ar);
+    free(rt);
+}
@@ -0,0 +1,88 @@
+/**
+ * rx_tree.h
+ *
+ * radix tree (path-compressed trie) over the same strings as the string hash table in
+ * strh_table.h, which can also count the inserted strings that start with a prefix.
+ * each edge of the tree is labeled with a run of chars, and each node with more than
+ * one child or the end of an inserted string, so a tree of n distinct strings has at
+ * most 2n nodes. besides the no. times the string ending at it was inserted, every
+ * node holds the no. strings inserted below it (its subtree count), so
+ * rx_tree_nsearch and rx_tree_npsearch only walk the path spelled by their argument,
+ * which takes O(|s|) time no matter how many strings were inserted. answering a
+ * prefix query with an h_table means looking at every string in it.
+ *
+ * edge labels point into copies of the inserted strings, and nodes and labels are
+ * allocated from an arena. the children of a node are kept in one array, followed by
+ * the first char of each child's label, which is searched with memchr.
+ *
+ * header file that contains declarations for functions, macros, and the structs.
+ *
+ * sample usage:
+ *
+ * rx_tree *rt = new_rx_tree();
+ * rx_tree_insert(rt, "abc");
+ * rx_tree_insert(rt, "abd");
+ * rx_tree_insert(rt, "abc");
+ * // 2, 3, 0
+ * printf("%d %d %d\n", rx_tree_nsearch(rt, "abc"), rx_tree_npsearch(rt, "ab"),
+ *        rx_tree_nsearch(rt, "ab"));
+ * free_rx_tree(rt);
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#ifndef RX_TREE_H
+#define RX_TREE_H
+
+#include <stddef.h>
+#include <stdint.h>
+// for d_arena
+#include "d_alloc.h"
+
+// first chars of the labels of the children of node x, which follow x->ch
+#define RX_FC(x) ((unsigned char *) ((x)->ch + (x)->n_ch))
+// radix tree node
+struct rx_node {
+    // label of the edge into the node (not '\0' terminated), and its length
+    char *lab;
+    uint32_t len;
+    // no. children
+    uint32_t n_ch;
+    // no. times the string ending at the node was inserted, and no. strings inserted
+    // that start with it
+    int cnt, sub;
+    // children, followed by the first char of each child's label (see RX_FC)
+    struct rx_node **ch;
+};
+typedef struct rx_node rx_node;
+// radix tree
+struct rx_tree {
+    // root node, with an empty label; root->sub is the no. strings inserted
+    rx_node *root;
+    // no. nodes, no. distinct strings
+    size_t n, n_d;
+    // no. bytes used by the tree, its nodes, labels, and child arrays, not counting
+    // malloc or arena overhead
+    size_t mem;
+    // arena for nodes and labels
+    d_arena *ar;
+};
+typedef struct rx_tree rx_tree;
+// return a pointer to a new, empty radix tree
+rx_tree *new_rx_tree(void);
+// insert a string into the tree
+void rx_tree_insert(rx_tree *rt, char *s);
+// search for a string in the tree; returns occurrences of s in the tree
+int rx_tree_nsearch(rx_tree *rt, char *s);
+// returns the no. strings inserted into the tree that start with p (all of them if p
+// is empty), counting each insert
+int rx_tree_npsearch(rx_tree *rt, char *p);
+// free a radix tree
+void free_rx_tree(rx_tree *rt);
+
+#endif /* RX_TREE_H */
@@ -0,0 +1,186 @@
+/**
+ * sh_table.c
+ *
+ * open addressing ("Swiss table") version of the string hash table in strh_table.h.
+ * see sh_table.h for how the table is laid out and searched.
+ *
+ * source file that contains function definitions.
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "sh_table.h"
+
+// returns a mask with bit i set if control byte i of the group at g equals c
+#ifdef __SSE2__
+static inline unsigned sh_match(const int8_t *g, int8_t c) {
+    __m128i v = _mm_load_si128((const __m128i *) g);
+    return (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(c)));
+}
+#else
+static inline unsigned sh_match(const int8_t *g, int8_t c) {
+    unsigned m = 0;
+    int i;
+    for (i = 0; i < SH_GRP; i++) {
+        m |= (unsigned) (g[i] == c) << i;
+    }
+    return m;
+}
+#endif
+
+// returns the index of the lowest set bit of m, which must not be 0
+static inline int sh_ctz(unsigned m) {
+#ifdef __GNUC__
+    return __builtin_ctz(m);
+#else
+    int i = 0;
+    while ((m & 1) == 0) { m >>= 1; i++; }
+    return i;
+#endif
+}
+
+// control byte and first group to probe for hash h in a table of cap slots
+#define SH_H2(h) ((int8_t) ((h) & 0x7f))
+#define SH_H1(h, cap) ((size_t) ((h) >> 7) & ((cap) / SH_GRP - 1))
+
+// returns the index of the slot holding string s with hash h, or if s is not in the
+// table, the index of the empty slot s would be inserted into. the table always has
+// empty slots, so the probe ends. groups are probed in triangular order (g, g + 1,
+// g + 3, ...), which visits every group since the no. groups is a power of 2
+static size_t sh_find(sh_table *st, const char *s, uint64_t h) {
+    size_t g_m = st->cap / SH_GRP - 1;
+    size_t g = SH_H1(h, st->cap);
+    size_t i, k;
+    int8_t c = SH_H2(h);
+    unsigned m;
+    for (k = 1; ; k++) {
+        const int8_t *grp = st->ctrl + g * SH_GRP;
+        // check each slot whose control byte matches
+        for (m = sh_match(grp, c); m != 0; m &= m - 1) {
+            i = g * SH_GRP + sh_ctz(m);
+            if (st->slots[i].h == h && strcmp(st->slots[i].str, s) == 0) {
+                return i;
+            }
+        }
+        // an empty slot in the group means s is not further along the probe
+        m = sh_match(grp, SH_EMPTY);
+        if (m != 0) {
+            return g * SH_GRP + sh_ctz(m);
+        }
+        g = (g + k) & g_m;
+    }
+}
+
+// returns the index of the first empty slot on the probe for hash h
+static size_t sh_find_empty(sh_table *st, uint64_t h) {
+    size_t g_m = st->cap / SH_GRP - 1;
+    size_t g = SH_H1(h, st->cap);
+    size_t k;
+    unsigned m;
+    for (k = 1; (m = sh_match(st->ctrl + g * SH_GRP, SH_EMPTY)) == 0; k++) {
+        g = (g + k) & g_m;
+    }
+    return g * SH_GRP + sh_ctz(m);
+}
+
+// allocates cap empty slots and their control bytes for st
+static void sh_alloc(sh_table *st, size_t cap) {
+    st->cap = cap;
+    st->ctrl = (int8_t *) aligned_alloc(SH_GRP, cap);
+    st->slots = (sh_slot *) malloc(cap * sizeof(sh_slot));
+    assert(st->ctrl != NULL && st->slots != NULL);
+    memset(st->ctrl, SH_EMPTY, cap);
+}
+
+// doubles the no. slots of st, moving each string to its slot in the new table
+static void sh_grow(sh_table *st) {
+    int8_t *o_ctrl = st->ctrl;
+    sh_slot *o_slots = st->slots;
+    size_t o_cap = st->cap;
+    size_t i, j;
+    sh_alloc(st, 2 * o_cap);
+    for (i = 0; i < o_cap; i++) {
+        if (o_ctrl[i] != SH_EMPTY) {
+            // strings are distinct, so the probe only needs to find an empty slot
+            j = sh_find_empty(st, o_slots[i].h);
+            st->ctrl[j] = o_ctrl[i];
+            st->slots[j] = o_slots[i];
+        }
+    }
+    free(o_ctrl);
+    free(o_slots);
+}
+
+// return a pointer to a new table that can hold n distinct strings before growing,
+// using h_fnv1a
+sh_table *new_sh_table(size_t n) {
+    return new_sh_table_hf(n, h_fnv1a);
+}
+// return a pointer to a new table that can hold n distinct strings before growing,
+// using hash function hf
+sh_table *new_sh_table_hf(size_t n, h_func hf) {
+    assert(hf != NULL);
+    sh_table *st = (sh_table *) malloc(sizeof(sh_table));
+    assert(st != NULL);
+    // smallest power of 2 no. slots, at least one group, that is at most 7/8 full
+    size_t cap = SH_GRP;
+    while (cap - cap / 8 < n) { cap *= 2; }
+    sh_alloc(st, cap);
+    st->siz = 0;
+    st->hf = hf;
+    return st;
+}
+// insert a new string into the table
+void sh_table_insert(sh_table *st, char *s) {
+    size_t n = strlen(s);
+    assert(st != NULL && n > 0);
+    uint64_t h = st->hf(s, n);
+    size_t i = sh_find(st, s, h);
+    // if s is already in the table, count it again
+    if (st->ctrl[i] != SH_EMPTY) {
+        st->slots[i].n++;
+        return;
+    }
+    // else grow first if the table would be more than 7/8 full
+    if (st->siz + 1 > st->cap - st->cap / 8) {
+        sh_grow(st);
+        i = sh_find_empty(st, h);
+    }
+    char *t = (char *) malloc(n + 1);
+    assert(t != NULL);
+    memcpy(t, s, n + 1);
+    st->ctrl[i] = SH_H2(h);
+    st->slots[i].str = t;
+    st->slots[i].h = h;
+    st->slots[i].n = 1;
+    st->siz++;
+}
+// search for a string in the table; returns occurrences of s in the table
+int sh_table_nsearch(sh_table *st, char *s) {
+    size_t n = strlen(s);
+    assert(st != NULL && n > 0);
+    size_t i = sh_find(st, s, st->hf(s, n));
+    return (st->ctrl[i] == SH_EMPTY) ? 0 : st->slots[i].n;
+}
+// free a table
+void free_sh_table(sh_table *st) {
+    assert(st != NULL);
+    size_t i;
+    for (i = 0; i < st->cap; i++) {
+        if (st->ctrl[i] != SH_EMPTY) { free(st->slots[i].str); }
+    }
+    free(st->ctrl);
+    free(st->slots);
+    free(st);
+}
@@ -0,0 +1,76 @@
+/**
+ * sh_table.h
+ *
+ * open addressing ("Swiss table") version of the string hash table in strh_table.h.
+ * each distinct string is stored once, with the no. times it was inserted, in a flat
+ * array of slots. a parallel array of control bytes holds one byte per slot: SH_EMPTY
+ * if the slot is empty, else the low 7 bits of the hash of the slot's string. slots
+ * are searched 16 at a time by comparing the control bytes of a group of 16 slots to
+ * the 7-bit hash of the key at once, with SSE2 if the compiler targets it and a
+ * portable loop otherwise, so a search usually touches one group of control bytes and
+ * one slot, instead of following a linked list of nodes.
+ *
+ * sh_table_insert and sh_table_nsearch do the same thing as h_table_insert and
+ * h_table_nsearch. the table doubles its no. slots when more than 7/8 of them are in
+ * use, so its size does not have to be picked up front.
+ *
+ * header file that contains declarations for functions, macros, and the structs.
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#ifndef SH_TABLE_H
+#define SH_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+// for h_func and h_fnv1a
+#include "strh_table.h"
+
+// no. slots in a group; slots are probed a group at a time
+#define SH_GRP 16
+// control byte of an empty slot; a used slot's control byte is in [0, 127]
+#define SH_EMPTY ((int8_t) -128)
+// slot of a sh_table
+struct sh_slot {
+    // pointer to string
+    char *str;
+    // full hash of str
+    uint64_t h;
+    // no. times str was inserted
+    int n;
+};
+typedef struct sh_slot sh_slot;
+// open addressing string hash table
+struct sh_table {
+    // control bytes, one per slot, 16-byte aligned
+    int8_t *ctrl;
+    // array of slots
+    sh_slot *slots;
+    // no. slots (a power of 2 that is at least SH_GRP), no. distinct strings
+    size_t cap, siz;
+    // hash function used for the table
+    h_func hf;
+};
+typedef struct sh_table sh_table;
+// return a pointer to a new table that can hold n distinct strings before growing,
+// using h_fnv1a
+sh_table *new_sh_table(size_t n);
+// return a pointer to a new table that can hold n distinct strings before growing,
+// using hash function hf. the control byte comes from the low 7 bits of the hash and
+// the group probed first from the bits above them (bit 7 and up), so hf should mix
+// its low bits well. h_sum works but puts most strings in the same few groups
+sh_table *new_sh_table_hf(size_t n, h_func hf);
+// insert a new string into the table
+void sh_table_insert(sh_table *st, char *s);
+// search for a string in the table; returns occurrences of s in the table
+int sh_table_nsearch(sh_table *st, char *s);
+// free a table
+void free_sh_table(sh_table *st);
+
+#endif /* SH_TABLE_H */
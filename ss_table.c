@@ -0,0 +1,238 @@
+/**
+ * ss_table.c
+ *
+ * Space-Saving top-k counter over a stream summary, for the most frequent strings of
+ * a stream in fixed memory. see ss_table.h for the error bounds.
+ *
+ * source file that contains function definitions.
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ss_table.h"
+
+// returns the index slot of string s with hash h, or the empty slot where it would
+// go if it has no counter
+static size_t ss_slot(ss_table *ss, const char *s, uint64_t h) {
+    size_t i = h & (ss->i_siz - 1);
+    ss_node *x;
+    while (ss->idx[i] != 0) {
+        x = ss->c + ss->idx[i] - 1;
+        if (x->h == h && strcmp(x->str, s) == 0) { return i; }
+        i = (i + 1) & (ss->i_siz - 1);
+    }
+    return i;
+}
+
+// empties slot i of the index. the entries after it are shifted back into the gap
+// unless that would put them before their home slot, so no tombstones are needed
+static void ss_unslot(ss_table *ss, size_t i) {
+    size_t j = i, home, mask = ss->i_siz - 1;
+    for (;;) {
+        j = (j + 1) & mask;
+        if (ss->idx[j] == 0) { break; }
+        home = ss->c[ss->idx[j] - 1].h & mask;
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            ss->idx[i] = ss->idx[j];
+            i = j;
+        }
+    }
+    ss->idx[i] = 0;
+}
+
+// returns an unused bucket with count cnt, linked into the bucket list after b, or
+// first if b is NULL
+static ss_bucket *ss_bucket_new(ss_table *ss, ss_bucket *b, int cnt) {
+    ss_bucket *nb = ss->fb;
+    assert(nb != NULL);
+    ss->fb = nb->next;
+    nb->cnt = cnt;
+    nb->first = NULL;
+    nb->prev = b;
+    nb->next = (b != NULL) ? b->next : ss->min;
+    if (nb->next != NULL) { nb->next->prev = nb; }
+    else { ss->max = nb; }
+    if (b != NULL) { b->next = nb; }
+    else { ss->min = nb; }
+    return nb;
+}
+
+// takes x out of its bucket. the bucket is unlinked and made unused if it is empty
+static void ss_detach(ss_table *ss, ss_node *x) {
+    ss_bucket *b = x->b;
+    if (x->prev != NULL) { x->prev->next = x->next; }
+    else { b->first = x->next; }
+    if (x->next != NULL) { x->next->prev = x->prev; }
+    if (b->first != NULL) { return; }
+    if (b->prev != NULL) { b->prev->next = b->next; }
+    else { ss->min = b->next; }
+    if (b->next != NULL) { b->next->prev = b->prev; }
+    else { ss->max = b->prev; }
+    b->next = ss->fb;
+    ss->fb = b;
+}
+
+// puts x first in bucket b
+static void ss_attach(ss_node *x, ss_bucket *b) {
+    x->b = b;
+    x->prev = NULL;
+    x->next = b->first;
+    if (b->first != NULL) { b->first->prev = x; }
+    b->first = x;
+}
+
+// adds 1 to the count of x, moving it to the bucket after its own, which is made if
+// it does not have count cnt + 1. if x is alone in its bucket, the bucket's count is
+// incremented instead
+static void ss_incr(ss_table *ss, ss_node *x) {
+    ss_bucket *b = x->b, *nb = b->next;
+    x->cnt++;
+    if (nb != NULL && nb->cnt == x->cnt) {
+        ss_detach(ss, x);
+        ss_attach(x, nb);
+    }
+    else if (x->prev == NULL && x->next == NULL) {
+        b->cnt++;
+    }
+    else {
+        nb = ss_bucket_new(ss, b, x->cnt);
+        ss_detach(ss, x);
+        ss_attach(x, nb);
+    }
+}
+
+// return a pointer to a new top-k counter with m counters that uses h_fnv1a
+ss_table *new_ss_table(size_t m) {
+    return new_ss_table_hf(m, h_fnv1a);
+}
+
+// return a pointer to a new top-k counter with m counters that uses hash function hf
+ss_table *new_ss_table_hf(size_t m, h_func hf) {
+    assert(m > 0 && m < UINT32_MAX && hf != NULL);
+    ss_table *ss = (ss_table *) malloc(sizeof(ss_table));
+    assert(ss != NULL);
+    size_t i;
+    ss->m = m;
+    ss->n_c = 0;
+    ss->c = (ss_node *) calloc(m, sizeof(ss_node));
+    assert(ss->c != NULL);
+    // there are never more distinct counts than counters
+    ss->bk = (ss_bucket *) malloc(m * sizeof(ss_bucket));
+    assert(ss->bk != NULL);
+    for (i = 0; i < m; i++) {
+        ss->bk[i].next = (i + 1 < m) ? ss->bk + i + 1 : NULL;
+    }
+    ss->fb = ss->bk;
+    ss->min = ss->max = NULL;
+    // at most half full
+    for (ss->i_siz = 2; ss->i_siz < 2 * m; ss->i_siz *= 2)
+        ;
+    ss->idx = (uint32_t *) calloc(ss->i_siz, sizeof(uint32_t));
+    assert(ss->idx != NULL);
+    ss->n = 0;
+    ss->hf = hf;
+    return ss;
+}
+
+// insert a string into the table. a string without a counter gets an unused one with
+// count 1, or once they are all in use, takes over the first counter of the bucket
+// with the smallest count. the counter keeps its count, which becomes its error, and
+// is then incremented like any other
+void ss_table_insert(ss_table *ss, char *s) {
+    assert(ss != NULL && s != NULL);
+    size_t n = strlen(s), i;
+    uint64_t h = ss->hf(s, n);
+    ss_node *x;
+    ss->n++;
+    i = ss_slot(ss, s, h);
+    if (ss->idx[i] != 0) {
+        ss_incr(ss, ss->c + ss->idx[i] - 1);
+        return;
+    }
+    if (ss->n_c < ss->m) {
+        x = ss->c + ss->n_c++;
+        x->cnt = 1;
+        x->err = 0;
+        ss_attach(x, (ss->min != NULL && ss->min->cnt == 1) ? ss->min :
+                  ss_bucket_new(ss, NULL, 1));
+    }
+    else {
+        x = ss->min->first;
+        ss_unslot(ss, ss_slot(ss, x->str, x->h));
+        // s may have moved back into the emptied slot
+        i = ss_slot(ss, s, h);
+        x->err = x->cnt;
+        ss_incr(ss, x);
+    }
+    if (x->siz < n + 1) {
+        x->siz = (x->siz == 0) ? n + 1 : x->siz;
+        while (x->siz < n + 1) { x->siz *= 2; }
+        x->str = (char *) realloc(x->str, x->siz);
+        assert(x->str != NULL);
+    }
+    memcpy(x->str, s, n + 1);
+    x->h = h;
+    ss->idx[i] = (uint32_t) (x - ss->c) + 1;
+}
+
+// returns the counter of a string, or NULL if the string does not have one
+ss_node *ss_table_find(ss_table *ss, char *s) {
+    assert(ss != NULL && s != NULL);
+    size_t i = ss_slot(ss, s, ss->hf(s, strlen(s)));
+    return (ss->idx[i] != 0) ? ss->c + ss->idx[i] - 1 : NULL;
+}
+
+// search for a string in the table; returns its count if it has a counter, else the
+// smallest count
+int ss_table_nsearch(ss_table *ss, char *s) {
+    ss_node *x = ss_table_find(ss, s);
+    return (x != NULL) ? x->cnt : ss_table_min(ss);
+}
+
+// returns the smallest count of the table if all its counters are in use, else 0,
+// since then every string inserted has a counter
+int ss_table_min(ss_table *ss) {
+    assert(ss != NULL);
+    return (ss->n_c == ss->m) ? ss->min->cnt : 0;
+}
+
+// writes the (up to) n counters with the largest counts to top, largest first, by
+// walking the buckets down from the largest count
+size_t ss_table_top(ss_table *ss, ss_node **top, size_t n) {
+    assert(ss != NULL && (top != NULL || n == 0));
+    size_t i = 0;
+    ss_bucket *b;
+    ss_node *x;
+    for (b = ss->max; b != NULL && i < n; b = b->prev) {
+        for (x = b->first; x != NULL && i < n; x = x->next) { top[i++] = x; }
+    }
+    return i;
+}
+
+// returns the no. bytes used by the table, its counters, buckets, index, and strings
+size_t ss_table_mem(ss_table *ss) {
+    assert(ss != NULL);
+    size_t i, mem = sizeof(ss_table) + ss->m * (sizeof(ss_node) + sizeof(ss_bucket)) +
+        ss->i_siz * sizeof(uint32_t);
+    for (i = 0; i < ss->n_c; i++) { mem += ss->c[i].siz; }
+    return mem;
+}
+
+// free a top-k counter and its strings
+void free_ss_table(ss_table *ss) {
+    assert(ss != NULL);
+    size_t i;
+    for (i = 0; i < ss->n_c; i++) { free(ss->c[i].str); }
+    free(ss->c);
+    free(ss->bk);
+    free(ss->idx);
+    free(ss);
+}
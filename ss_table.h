@@ -0,0 +1,124 @@
+/**
+ * ss_table.h
+ *
+ * fixed-memory top-k counter for string streams, for when only the most frequent
+ * strings are wanted and a counted h_table (strh_table.h) of every distinct string
+ * would be too big. an ss_table keeps m counters and uses the Space-Saving
+ * algorithm: a string that has a counter gets it incremented, and a string that
+ * does not takes over the counter with the smallest count c, which it keeps
+ * incremented to c + 1, and remembers c as the error of its count.
+ *
+ * so for a string whose counter has count cnt and error err, the true no. times it
+ * was inserted is between cnt - err and cnt, and err is at most N / m for N inserts
+ * in all. every string inserted more than N / m times has a counter, and a string
+ * without a counter was inserted at most as many times as the smallest count (see
+ * ss_table_min). the counts of a skewed stream are usually exact or close to it for
+ * the most frequent strings, even with m much smaller than the no. distinct strings.
+ *
+ * the counters are kept in a stream summary: a list of buckets in increasing order
+ * of count, each with a list of the counters that have that count. incrementing a
+ * counter moves it to the next bucket (or makes one), and the smallest counter is
+ * always in the first bucket, so every insert takes O(1) time. counters are found
+ * by string with an open addressing index of 2m to 4m slots. apart from the strings
+ * themselves, whose buffers grow to fit the longest string a counter has held, all
+ * memory is allocated by new_ss_table.
+ *
+ * header file that contains declarations for functions, macros, and the structs.
+ *
+ * sample usage:
+ *
+ * ss_table *ss = new_ss_table(SS_M);
+ * ss_node *top[10];
+ * size_t i, n;
+ * // ...for each string s in the stream...
+ * ss_table_insert(ss, s);
+ * n = ss_table_top(ss, top, 10);
+ * for (i = 0; i < n; i++) {
+ *     printf("%s: %d to %d\n", top[i]->str, top[i]->cnt - top[i]->err, top[i]->cnt);
+ * }
+ * free_ss_table(ss);
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#ifndef SS_TABLE_H
+#define SS_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+// for h_func and h_fnv1a
+#include "strh_table.h"
+
+// default no. counters
+#define SS_M 1024
+struct ss_bucket;
+// counter for one string
+struct ss_node {
+    // string, '\0' terminated, and the no. bytes allocated for it
+    char *str;
+    size_t siz;
+    // hash of the string
+    uint64_t h;
+    // count, and how much of it may be from other strings (see above)
+    int cnt, err;
+    // previous and next counters in the same bucket
+    struct ss_node *prev, *next;
+    // bucket the counter is in, whose count is cnt
+    struct ss_bucket *b;
+};
+typedef struct ss_node ss_node;
+// bucket of the counters with count cnt
+struct ss_bucket {
+    int cnt;
+    // first counter in the bucket
+    ss_node *first;
+    // buckets with the next smaller and larger counts
+    struct ss_bucket *prev, *next;
+};
+typedef struct ss_bucket ss_bucket;
+// Space-Saving top-k counter
+struct ss_table {
+    // counters, m of them, n_c of which are in use
+    ss_node *c;
+    size_t m, n_c;
+    // buckets, m of them; the buckets with the smallest and largest counts, and the
+    // first unused bucket (unused buckets are linked by next)
+    ss_bucket *bk, *min, *max, *fb;
+    // index of the counters: 1 + the index of a counter in c, or 0 if the slot is
+    // empty. i_siz is a power of 2
+    uint32_t *idx;
+    size_t i_siz;
+    // no. strings inserted
+    uint64_t n;
+    // hash function used for the table
+    h_func hf;
+};
+typedef struct ss_table ss_table;
+// return a pointer to a new top-k counter with m counters that uses h_fnv1a
+ss_table *new_ss_table(size_t m);
+// return a pointer to a new top-k counter with m counters that uses hash function hf
+ss_table *new_ss_table_hf(size_t m, h_func hf);
+// insert a string into the table
+void ss_table_insert(ss_table *ss, char *s);
+// returns the counter of a string, or NULL if the string does not have one
+ss_node *ss_table_find(ss_table *ss, char *s);
+// search for a string in the table; returns its count if it has a counter, else the
+// smallest count. either way, the true count is never more than that
+int ss_table_nsearch(ss_table *ss, char *s);
+// returns the smallest count of the table if all its counters are in use, else 0
+int ss_table_min(ss_table *ss);
+// writes the (up to) n counters with the largest counts to top, largest first, and
+// returns how many it wrote. the pointers are valid until the next insert
+size_t ss_table_top(ss_table *ss, ss_node **top, size_t n);
+// returns the no. bytes used by the table, including its strings, not counting
+// malloc overhead
+size_t ss_table_mem(ss_table *ss);
+// free a top-k counter
+void free_ss_table(ss_table *ss);
+
+#endif /* SS_TABLE_H */
@@ -5,6 +5,21 @@
  *
  * Changelog:
  *
+ * 10-17-2026
+ *
+ * hashing goes through the table's h_func, with h_fnv1a as the default, and is done
+ * once per insert or search, as is strlen. the hash is stored in each node so that
+ * searches only strcmp strings with the same hash. fixed the string copy in
+ * h_table_insert not being null-terminated. added h_table_stats. added growth by max
+ * load factor (h_table_set_max_lf), with the nodes moved to the bigger table a few
+ * buckets per insert (h_table_rehash finishes the move at once). added counted mode, in
+ * which new strings go first in their chain. strings are stored after their length,
+ * which is compared before the string itself, and with H_ARENA, nodes and strings come
+ * from arenas instead of malloc. added h_table_nsearch_batch. added h_table_mem. added
+ * the optional blocked Bloom filter, which is checked before the chain walk of searches
+ * and counted inserts. h_fnv1a and the Bloom filter use h_mix64 from the header instead
+ * of their own finalizers
+ *
  * 09-19-2018
  *
  * copied from solution to HackerRank Sparse Arrays problem; added change log
@@ -12,23 +27,83 @@
  */
 
 #include <assert.h>
+#include <math.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "strh_table.h"
 
-// return a pointer to a new hash table of some size
+// hint to bring the memory at p into the cache, since it will be read soon
+#ifdef __GNUC__
+#define H_PREFETCH(p) __builtin_prefetch(p)
+#else
+#define H_PREFETCH(p)
+#endif
+// block of the Bloom filter of ht for hash h, and the hash that picks the bits in it.
+// the block is the top 32 bits of h scaled to [0, bl_n), so bl_n need not be a power
+// of 2 and the filter can have exactly as many blocks as its false positive rate needs
+#define H_BLOOM_BLOCK(ht, h) \
+    ((ht)->bl + (((h) >> 32) * (ht)->bl_n >> 32) * (H_BLOOM_BLK / 64))
+#define H_BLOOM_H2(h) h_mix64((h) + 0x9e3779b97f4a7c15ULL)
+// true if node np holds the kn char string ks with hash kh
+#define HT_NODE_EQ(np, ks, kn, kh) \
+    ((np)->h == (kh) && HT_STR_LEN((np)->str) == (kn) && \
+     memcmp((np)->str, (ks), (kn)) == 0)
+
+// return a pointer to a new hash table of some size that uses h_fnv1a
 h_table *new_h_table(int s) {
-    assert(s > 0);
+    return new_h_table_hf(s, h_fnv1a, 0);
+}
+// return a pointer to a new hash table of some size that uses hash function hf
+h_table *new_h_table_hf(int s, h_func hf, int flags) {
+    assert(s > 0 && hf != NULL && (flags & ~(H_COUNTED | H_ARENA)) == 0);
     // malloc hash table
     h_table *ht = (h_table *) malloc(sizeof(h_table));
     // malloc array of ht_node * and set them to NULL
     ht->table = (ht_node **) malloc(s * sizeof(ht_node *));
     memset(ht->table, 0, s * sizeof(ht_node *));
-    // set size of hash table
+    // set size and hash function of hash table, no rehash in progress
     ht->siz = s;
+    ht->hf = hf;
+    ht->counted = flags & H_COUNTED;
+    ht->n = 0;
+    ht->max_lf = H_MAX_LF;
+    ht->o_table = NULL;
+    ht->o_siz = ht->o_i = 0;
+    // arenas for nodes and strings
+    ht->ar_n = (flags & H_ARENA) ? d_arena__new(D_ARENA__BLK_SIZ) : NULL;
+    ht->ar_k = (flags & H_ARENA) ? d_arena__new(D_ARENA__BLK_SIZ) : NULL;
+    // no Bloom filter until h_table_set_bloom is called
+    ht->bl = NULL;
+    ht->bl_n = ht->bl_cap = 0;
+    ht->bl_k = 0;
+    ht->bl_bits = 0;
     // return pointer
     return ht;
 }
+// 64-bit FNV-1a hash, followed by the murmur3 finalizer so that the low bits used
+// for the bucket index depend on every char of s. default hash for h_table
+uint64_t h_fnv1a(const char *s, size_t n) {
+    // FNV-1a 64-bit offset basis and prime
+    uint64_t h = 14695981039346656037ULL;
+    size_t i;
+    for (i = 0; i < n; i++) {
+        h ^= (unsigned char) s[i];
+        h *= 1099511628211ULL;
+    }
+    // FNV-1a mixes low bits into high bits only, so mix the high bits back down
+    return h_mix64(h);
+}
+// sum of the chars of s plus 6691, which is what hfunc uses. every anagram of s has
+// the same hash; only useful for comparisons with h_fnv1a
+uint64_t h_sum(const char *s, size_t n) {
+    int sum = 0;
+    size_t i;
+    for (i = 0; i < n; i++) {
+        sum += s[i];
+    }
+    return (uint64_t) (sum + 6691);
+}
 // hash function for the table; not platform portable
 // generates integer hash for given string and table size
 int hfunc(char *s, int siz) {
@@ -44,23 +119,191 @@ int hfunc(char *s, int siz) {
     // add by prime; mod by table size
     return (sum + 6691) % siz;
 }
+// set the max load factor of the hash table; lf = 0 keeps the no. buckets fixed
+void h_table_set_max_lf(h_table *ht, double lf) {
+    assert(ht != NULL && lf >= 0);
+    ht->max_lf = lf;
+}
+// move up to k buckets of the old table to the new table during a rehash
+static void h_table_rehash_n(h_table *ht, int k) {
+    ht_node *hp, *hn;
+    int i;
+    while (ht->o_table != NULL && k-- > 0) {
+        // move each node to the front of its bucket in the new table
+        hp = *(ht->o_table + ht->o_i);
+        while (hp != NULL) {
+            hn = hp->next;
+            i = (int) (hp->h % (uint64_t) ht->siz);
+            hp->next = *(ht->table + i);
+            *(ht->table + i) = hp;
+            hp = hn;
+        }
+        // if that was the last bucket, the rehash is done
+        if (++ht->o_i == ht->o_siz) {
+            free(ht->o_table);
+            ht->o_table = NULL;
+        }
+    }
+}
+// finish any rehash in progress at once
+void h_table_rehash(h_table *ht) {
+    assert(ht != NULL);
+    h_table_rehash_n(ht, ht->o_siz);
+}
+// start moving the nodes to a table with twice as many buckets
+static void h_table_grow(h_table *ht) {
+    // a low max load factor can fill the new table before the last rehash is done
+    h_table_rehash(ht);
+    ht->o_table = ht->table;
+    ht->o_siz = ht->siz;
+    ht->o_i = 0;
+    ht->siz *= 2;
+    ht->table = (ht_node **) calloc(ht->siz, sizeof(ht_node *));
+    assert(ht->table != NULL);
+}
+// set the bl_k bits of hash h in its Bloom filter block. bit i is at a + i * b in the
+// block, where a and b (odd) come from different bits of H_BLOOM_H2(h)
+static inline void h_bloom_add(h_table *ht, uint64_t h) {
+    uint64_t *blk = H_BLOOM_BLOCK(ht, h), h2 = H_BLOOM_H2(h);
+    uint64_t a = h2, b = (h2 >> 32) | 1;
+    int i;
+    for (i = 0; i < ht->bl_k; i++, a += b) {
+        blk[(a % H_BLOOM_BLK) / 64] |= (uint64_t) 1 << (a % 64);
+    }
+}
+// returns nonzero if all the bits of hash h are set in its Bloom filter block, which
+// they are for every hash added
+static inline int h_bloom_has(h_table *ht, uint64_t h) {
+    uint64_t *blk = H_BLOOM_BLOCK(ht, h), h2 = H_BLOOM_H2(h);
+    uint64_t a = h2, b = (h2 >> 32) | 1;
+    int i;
+    for (i = 0; i < ht->bl_k; i++, a += b) {
+        if ((blk[(a % H_BLOOM_BLK) / 64] & ((uint64_t) 1 << (a % 64))) == 0) { return 0; }
+    }
+    return 1;
+}
+// (re)allocates the Bloom filter of ht with room for at least cap nodes at bl_bits
+// bits per node, and adds the hash of every node in the table to it. bl_cap is set to
+// the no. nodes the blocks have room for, so it is never 0
+static void h_bloom_build(h_table *ht, size_t cap) {
+    ht_node *hp;
+    int i;
+    free(ht->bl);
+    ht->bl_n = (size_t) (cap * ht->bl_bits / H_BLOOM_BLK) + 1;
+    assert(ht->bl_n <= UINT32_MAX);
+    ht->bl_cap = (size_t) (ht->bl_n * H_BLOOM_BLK / ht->bl_bits);
+    ht->bl = (uint64_t *) aligned_alloc(64, ht->bl_n * (H_BLOOM_BLK / 8));
+    assert(ht->bl != NULL);
+    memset(ht->bl, 0, ht->bl_n * (H_BLOOM_BLK / 8));
+    for (i = 0; i < ht->siz; i++) {
+        for (hp = *(ht->table + i); hp != NULL; hp = hp->next) {
+            h_bloom_add(ht, hp->h);
+        }
+    }
+    for (i = ht->o_i; ht->o_table != NULL && i < ht->o_siz; i++) {
+        for (hp = *(ht->o_table + i); hp != NULL; hp = hp->next) {
+            h_bloom_add(ht, hp->h);
+        }
+    }
+}
+// add a blocked Bloom filter to the table, sized for n nodes with a false positive
+// rate of about fp, or remove it if fp is 0. bl_k = ln(2) * bits per node is the no.
+// bits per node that gives the lowest false positive rate. a blocked filter has a
+// somewhat higher rate than a plain one with as many bits, since some blocks get more
+// strings than others, and the gap grows as fp gets smaller. so it gets 20% more bits
+// than a plain filter needs for fp = 0.01, and 20% more again for each factor of 10
+void h_table_set_bloom(h_table *ht, size_t n, double fp) {
+    assert(ht != NULL && fp >= 0 && fp < 1);
+    if (fp == 0) {
+        free(ht->bl);
+        ht->bl = NULL;
+        ht->bl_n = ht->bl_cap = 0;
+        ht->bl_k = 0;
+        ht->bl_bits = 0;
+        return;
+    }
+    double bits = -log(fp) / (M_LN2 * M_LN2);
+    ht->bl_bits = bits * (1.0 + 0.2 * (-log10(fp) - 1.0));
+    ht->bl_k = (int) (M_LN2 * bits + 0.5);
+    if (ht->bl_k < 1) { ht->bl_k = 1; }
+    h_bloom_build(ht, (n > ht->n) ? n : ht->n);
+}
+// returns 0 if the Bloom filter of the table shows that s was never inserted, else 1
+int h_table_maybe(h_table *ht, char *s) {
+    assert(ht != NULL && s != NULL);
+    return ht->bl == NULL || h_bloom_has(ht, ht->hf(s, strlen(s)));
+}
+// returns the first node holding the n char string s with hash h, or NULL if s is
+// not in ht
+static ht_node *h_table_find(h_table *ht, char *s, size_t n, uint64_t h) {
+    ht_node *hp = *(ht->table + h % (uint64_t) ht->siz);
+    int i;
+    while (hp != NULL && !HT_NODE_EQ(hp, s, n, h)) { hp = hp->next; }
+    // during a rehash, s may still be in the old table
+    if (hp == NULL && ht->o_table != NULL) {
+        i = (int) (h % (uint64_t) ht->o_siz);
+        hp = (i >= ht->o_i) ? *(ht->o_table + i) : NULL;
+        while (hp != NULL && !HT_NODE_EQ(hp, s, n, h)) { hp = hp->next; }
+    }
+    return hp;
+}
 // insert a new string into the hash table
 void h_table_insert(h_table *ht, char *s) {
-    // get length of string
-    int n = strlen(s);
+    // get length and hash of string
+    size_t n = strlen(s);
     assert(n > 0);
-    // create a new ht_node
-    ht_node *htn = (ht_node *) malloc(sizeof(ht_node));
-    // malloc string space needed for s and copy s to t
-    char *t = (char *) malloc(n * sizeof(char) + 1);
-    strncpy(t, s, n);
-    // point htn->str to t, set next to NULL
+    uint64_t h = ht->hf(s, n);
+    // move a few buckets if rehashing
+    h_table_rehash_n(ht, H_REHASH_N);
+    // in counted mode, if s is already in the table, count it again. if the Bloom
+    // filter does not have h, s is not in the table
+    if (ht->counted && (ht->bl == NULL || h_bloom_has(ht, h))) {
+        ht_node *hc = h_table_find(ht, s, n, h);
+        if (hc != NULL) {
+            hc->cnt++;
+            return;
+        }
+    }
+    // start a rehash if the table is too full
+    if (ht->max_lf > 0 && ht->n + 1 > ht->max_lf * ht->siz) {
+        h_table_grow(ht);
+    }
+    ht->n++;
+    // add h to the Bloom filter, doubling the filter first if it is full
+    if (ht->bl != NULL) {
+        if (ht->n > ht->bl_cap) {
+            h_bloom_build(ht, 2 * ht->bl_cap);
+        }
+        h_bloom_add(ht, h);
+    }
+    // create a new ht_node, and space for the length of s, s, and its '\0'
+    ht_node *htn;
+    char *t;
+    if (ht->ar_n != NULL) {
+        htn = (ht_node *) d_arena__malloc(ht->ar_n, sizeof(ht_node));
+        t = (char *) d_arena__malloc(ht->ar_k, sizeof(uint32_t) + n + 1);
+    }
+    else {
+        htn = (ht_node *) malloc(sizeof(ht_node));
+        t = (char *) malloc(sizeof(uint32_t) + n * sizeof(char) + 1);
+    }
+    assert(htn != NULL && t != NULL && n <= UINT32_MAX);
+    // copy s after its length
+    t += sizeof(uint32_t);
+    HT_STR_LEN(t) = (uint32_t) n;
+    memcpy(t, s, n + 1);
+    // point htn->str to t, set hash and count, set next to NULL
     htn->str = t;
+    htn->h = h;
+    htn->cnt = 1;
     htn->next = NULL;
     // calculate index of hash table to insert
-    int ii = hfunc(s, ht->siz);
-    // if *(ht->table + ii) is NULL, set it to htn and exit function
-    if (*(ht->table + ii) == NULL) { 
+    int ii = (int) (htn->h % (uint64_t) ht->siz);
+    // if *(ht->table + ii) is NULL, set it to htn and exit function. in counted mode,
+    // each node holds a different string, so the order of a chain does not matter;
+    // htn goes first instead of walking the chain h_table_find just walked again
+    if (*(ht->table + ii) == NULL || ht->counted) {
+        htn->next = *(ht->table + ii);
         *(ht->table + ii) = htn;
         return;
     }
@@ -73,50 +316,219 @@ void h_table_insert(h_table *ht, char *s) {
     // set next of ht_node to htn
     hp->next = htn;
 }
+// returns the no. nodes in the chain at hp holding the n char string s with hash h
+static int h_table_ncount(ht_node *hp, char *s, size_t n, uint64_t h) {
+    int n_s = 0;
+    // while hp is not NULL
+    while (hp != NULL) {
+        // if the hashes match, see if the string hp->str points to is the same as s;
+        // if so increment n_s
+        if (HT_NODE_EQ(hp, s, n, h)) { n_s++; }
+        // else advance up the linked list
+        hp = hp->next;
+    }
+    return n_s;
+}
 // search for a string in the hash table; returns number of occurrences in the table
 int h_table_nsearch(h_table *ht, char *s) {
     // length of string s, number of occurrences of s in tablbe
-    int n, n_s;
+    size_t n;
+    int n_s;
     n = strlen(s);
     n_s = 0;
     assert(n > 0 && ht != NULL);
+    // hash s once
+    uint64_t h = ht->hf(s, n);
+    // if the Bloom filter does not have h, s is not in the table
+    if (ht->bl != NULL && !h_bloom_has(ht, h)) { return 0; }
+    // in counted mode, s is in at most one node
+    if (ht->counted) {
+        ht_node *hc = h_table_find(ht, s, n, h);
+        return (hc != NULL) ? hc->cnt : 0;
+    }
     // find index to search
-    int i = hfunc(s, ht->siz);
-    // pointer to ht_node * *(ht->table + i)
-    ht_node *hp = *(ht->table + i);
-    // while hp is not NULL
-    while (hp != NULL) {
-        // try to see if the string that hp->str points to is the same as s
-        int res = strcmp(s, hp->str);
-        // if res == 0 increment n_s
-        if (res == 0) { n_s++; }
-        // else advance up the linked list
-        hp = hp->next;
+    int i = (int) (h % (uint64_t) ht->siz);
+    n_s = h_table_ncount(*(ht->table + i), s, n, h);
+    // during a rehash, some nodes may still be in the old table
+    if (ht->o_table != NULL) {
+        i = (int) (h % (uint64_t) ht->o_siz);
+        if (i >= ht->o_i) { n_s += h_table_ncount(*(ht->o_table + i), s, n, h); }
     }
     // return n_s
     return n_s;
 }
-// free a hash table
-void free_h_table(h_table *ht) {
+// search for each of the n strings in keys, writing the no. occurrences of keys[i] in
+// the table to counts[i], H_BATCH strings at a time
+void h_table_nsearch_batch(h_table *ht, char **keys, size_t n, int *counts) {
+    assert(ht != NULL && ((keys != NULL && counts != NULL) || n == 0));
+    // lengths, hashes, and current chain nodes of the strings of a group
+    size_t len[H_BATCH];
+    uint64_t h[H_BATCH];
+    ht_node *hp[H_BATCH];
+    // first string of the group, no. strings in the group, index in group, no.
+    // strings whose chain has not been walked to the end
+    size_t g, m, j, act;
+    // searches below only look in ht->table
+    h_table_rehash(ht);
+    for (g = 0; g < n; g += H_BATCH) {
+        m = (n - g < H_BATCH) ? n - g : H_BATCH;
+        // hash each string and prefetch its bucket, unless the Bloom filter does not
+        // have the hash, in which case len is set to 0 to skip the string
+        for (j = 0; j < m; j++) {
+            len[j] = strlen(keys[g + j]);
+            assert(len[j] > 0);
+            h[j] = ht->hf(keys[g + j], len[j]);
+            counts[g + j] = 0;
+            if (ht->bl != NULL && !h_bloom_has(ht, h[j])) {
+                len[j] = 0;
+                continue;
+            }
+            H_PREFETCH(ht->table + h[j] % (uint64_t) ht->siz);
+        }
+        // read each chain head and prefetch it
+        for (j = 0; j < m; j++) {
+            hp[j] = (len[j] > 0) ? *(ht->table + h[j] % (uint64_t) ht->siz) : NULL;
+            if (hp[j] != NULL) { H_PREFETCH(hp[j]); }
+        }
+        // advance each chain by one node per round, prefetching the next node. nodes
+        // have cnt 1 unless the table is counted, and then the chain ends at a match
+        for (act = m; act > 0; ) {
+            act = 0;
+            for (j = 0; j < m; j++) {
+                if (hp[j] == NULL) { continue; }
+                if (HT_NODE_EQ(hp[j], keys[g + j], len[j], h[j])) {
+                    counts[g + j] += hp[j]->cnt;
+                    if (ht->counted) {
+                        hp[j] = NULL;
+                        continue;
+                    }
+                }
+                hp[j] = hp[j]->next;
+                if (hp[j] != NULL) {
+                    H_PREFETCH(hp[j]);
+                    act++;
+                }
+            }
+        }
+    }
+}
+// print no. nodes and distinct strings, bucket occupancy, and a histogram of the no.
+// distinct strings per bucket to f. the no. buckets a uniform hash is expected to use
+// for that many distinct strings is printed next to the actual one
+void h_table_stats(h_table *ht, FILE *f) {
+    assert(ht != NULL && f != NULL);
+    h_table_rehash(ht);
+    // no. nodes, distinct strings, non-empty buckets, most distinct strings in one
+    // bucket, nodes visited searching for every node, chain length, distinct strings
+    // in chain
+    size_t n, n_d, used, max, sq, len, d;
+    // no. buckets with each no. of distinct strings from 0 to max
+    size_t *hist;
+    ht_node *hp, *hq;
+    int i;
+    hist = (size_t *) calloc(2, sizeof(size_t));
+    assert(hist != NULL);
+    n = n_d = used = max = sq = 0;
+    for (i = 0; i < ht->siz; i++) {
+        len = d = 0;
+        for (hp = *(ht->table + i); hp != NULL; hp = hp->next) {
+            len++;
+            // hp is distinct if no earlier node in the chain has the same string
+            hq = *(ht->table + i);
+            while (hq != hp && (hq->h != hp->h || strcmp(hq->str, hp->str) != 0)) {
+                hq = hq->next;
+            }
+            if (hq == hp) { d++; }
+        }
+        n += len;
+        n_d += d;
+        // h_table_nsearch walks the whole chain, or in counted mode stops at the
+        // node it is looking for
+        sq += (ht->counted) ? len * (len + 1) / 2 : len * len;
+        if (len > 0) { used++; }
+        if (d > max) {
+            hist = (size_t *) realloc(hist, (d + 1) * sizeof(size_t));
+            assert(hist != NULL);
+            memset(hist + max + 1, 0, (d - max) * sizeof(size_t));
+            max = d;
+        }
+        hist[d]++;
+    }
+    // a uniform hash leaves each bucket empty with probability (1 - 1 / siz)^n_d
+    double p_e = 1.0;
+    for (d = 0; d < n_d; d++) { p_e *= 1.0 - 1.0 / ht->siz; }
+    fprintf(f, "nodes: %lu, distinct strings: %lu, buckets: %d\n", (unsigned long) n,
+            (unsigned long) n_d, ht->siz);
+    fprintf(f, "used buckets: %lu (uniform hash: %.1f), longest chain: %lu distinct\n",
+            (unsigned long) used, ht->siz * (1.0 - p_e), (unsigned long) max);
+    fprintf(f, "nodes visited per search of an inserted string: %.3f\n",
+            (n > 0) ? (double) sq / n : 0.0);
+    fprintf(f, "distinct strings in bucket: no. buckets\n");
+    for (d = 0; d <= max; d++) {
+        if (hist[d] > 0) {
+            fprintf(f, "%26lu: %lu\n", (unsigned long) d, (unsigned long) hist[d]);
+        }
+    }
+    free(hist);
+}
+// returns the no. bytes used by the table, not counting malloc or arena overhead
+size_t h_table_mem(h_table *ht) {
+    assert(ht != NULL);
+    size_t mem = sizeof(h_table) + ht->siz * sizeof(ht_node *);
+    ht_node *hp;
+    int i;
+    if (ht->o_table != NULL) { mem += ht->o_siz * sizeof(ht_node *); }
+    mem += ht->bl_n * (H_BLOOM_BLK / 8);
+    for (i = 0; i < ht->siz; i++) {
+        for (hp = *(ht->table + i); hp != NULL; hp = hp->next) {
+            mem += sizeof(ht_node) + sizeof(uint32_t) + HT_STR_LEN(hp->str) + 1;
+        }
+    }
+    for (i = ht->o_i; ht->o_table != NULL && i < ht->o_siz; i++) {
+        for (hp = *(ht->o_table + i); hp != NULL; hp = hp->next) {
+            mem += sizeof(ht_node) + sizeof(uint32_t) + HT_STR_LEN(hp->str) + 1;
+        }
+    }
+    return mem;
+}
+// free the nodes in buckets i to siz - 1 of table t
+static void free_ht_nodes(ht_node **t, int i, int siz) {
     // pointers to current and next ht_node
     ht_node *hn_c, *hn_n;
-    int i = 0;
     // for each list in the hash table
-    while (i < ht->siz) {
+    while (i < siz) {
         // set current and next
-        hn_c = *(ht->table + i++);
+        hn_c = *(t + i++);
         hn_n = (hn_c == NULL) ? NULL : hn_c->next;
         // while current (hn_c) is not null
         while (hn_c != NULL) {
             // free and update hn_c and hn_n
-            free(hn_c->str);
+            free(hn_c->str - sizeof(uint32_t));
             free(hn_c);
             hn_c = hn_n;
             hn_n = (hn_c == NULL) ? NULL : hn_c->next;
         }
     }
-    // free ht->table and ht
+}
+// free a hash table
+void free_h_table(h_table *ht) {
+    // with arenas, the nodes and strings are freed with the arenas
+    if (ht->ar_n != NULL) {
+        d_arena__free(ht->ar_n);
+        d_arena__free(ht->ar_k);
+    }
+    else {
+        free_ht_nodes(ht->table, 0, ht->siz);
+        // free the nodes not yet moved by a rehash in progress
+        if (ht->o_table != NULL) {
+            free_ht_nodes(ht->o_table, ht->o_i, ht->o_siz);
+        }
+    }
+    if (ht->o_table != NULL) {
+        free(ht->o_table);
+    }
+    // free the Bloom filter, ht->table, and ht
+    free(ht->bl);
     free(ht->table);
     free(ht);
 }
-
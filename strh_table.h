@@ -5,6 +5,23 @@
  *
  * Changelog:
  *
+ * 10-17-2026
+ *
+ * added pluggable hash functions (h_func); the default is h_fnv1a, and the old
+ * character sum hash is kept as h_sum for comparison. each node stores the full
+ * hash of its string, and h_table_stats reports bucket occupancy and chain lengths.
+ * the table now doubles its no. buckets when the no. nodes per bucket goes over a
+ * max load factor, moving the nodes over a few buckets per insert. added counted
+ * mode (H_COUNTED), where each distinct string is stored once with its no. occurrences.
+ * strings are stored after their length, and with H_ARENA, nodes and strings are
+ * allocated from d_arenas owned by the table, which are freed all at once. added
+ * h_table_nsearch_batch, which searches for a group of strings at once with prefetching.
+ * added h_table_mem, for comparing the memory used by the table to other structures.
+ * added an optional blocked Bloom filter (h_table_set_bloom), which lets searches for
+ * strings that were never inserted skip the chain walk. added h_mix64, the murmur3
+ * finalizer h_fnv1a ends with, so that the Bloom filter and the other tables that
+ * derive more hashes from a string's hash share one copy
+ *
  * 09-19-2018
  * 
  * copied from solution to HackerRank Sparse Arrays problem; added change log
@@ -13,12 +30,44 @@
 
 #ifndef STRH_TABLE_H
 #define STRH_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+// for d_arena
+#include "d_alloc.h"
+
 // default hash table size
 #define H_SIZ 512
+// default max load factor (nodes per bucket) before a table doubles its no. buckets
+#define H_MAX_LF 1.0
+// no. buckets of the old table moved to the new one by each insert during a rehash
+#define H_REHASH_N 4
+// flag for new_h_table_hf: store each distinct string once with a count, instead of
+// once per insert
+#define H_COUNTED 1
+// flag for new_h_table_hf: allocate nodes and strings from arenas, so that each takes
+// no malloc and free_h_table only frees one block per D_ARENA__BLK_SIZ bytes
+#define H_ARENA 2
+// no. strings h_table_nsearch_batch walks the chains of at the same time
+#define H_BATCH 16
+// default false positive rate for h_table_set_bloom, and the no. bits in each block
+// of the Bloom filter (one 64 byte cache line)
+#define H_BLOOM_FP 0.01
+#define H_BLOOM_BLK 512
+// length of the string of a ht_node, which is stored right before the string
+#define HT_STR_LEN(str) (*((uint32_t *) (str) - 1))
+// hash function type; returns a 64-bit hash of the n chars of s. the bucket of s
+// in a table of siz buckets is hash % siz, so the low bits must be well mixed
+typedef uint64_t (*h_func)(const char *s, size_t n);
 // hash table node
 struct ht_node {
-    // pointer to string
+    // pointer to string, which comes after its uint32_t length (see HT_STR_LEN)
     char *str;
+    // full hash of str, compared before str itself during searches
+    uint64_t h;
+    // no. times str was inserted; always 1 unless the table is in counted mode
+    int cnt;
     // pointer to next ht_node
     struct ht_node *next;
 };
@@ -29,17 +78,97 @@ struct h_table {
     ht_node **table;
     // size of table (number of ht_node linked lists in the table)
     int siz;
+    // hash function used for the table
+    h_func hf;
+    // nonzero if the table is in counted mode (created with H_COUNTED)
+    int counted;
+    // no. nodes in the table
+    size_t n;
+    // the table doubles when n > max_lf * siz; never if max_lf is 0
+    double max_lf;
+    // during a rehash, the old table, its size, and the index of the next bucket of
+    // the old table to move to table. buckets o_i to o_siz - 1 of o_table still hold
+    // nodes, and o_table is NULL when no rehash is in progress
+    ht_node **o_table;
+    int o_siz, o_i;
+    // with H_ARENA, arenas for nodes and for strings (with their lengths), else NULL
+    d_arena *ar_n, *ar_k;
+    // Bloom filter of the hashes of the nodes (see h_table_set_bloom), else NULL:
+    // bl_n blocks of H_BLOOM_BLK bits, with bl_k bits set in one block per hash and
+    // bl_bits bits per node. it is rebuilt twice as big when the table holds more
+    // than bl_cap nodes
+    uint64_t *bl;
+    size_t bl_n, bl_cap;
+    int bl_k;
+    double bl_bits;
 };
 typedef struct h_table h_table;
-// return a pointer to a new hash table of some size
+// return a pointer to a new hash table of some size that uses h_fnv1a
 h_table *new_h_table(int s);
+// return a pointer to a new hash table of some size that uses hash function hf.
+// flags is 0 or any of H_COUNTED and H_ARENA or'd together
+h_table *new_h_table_hf(int s, h_func hf, int flags);
+// murmur3 64-bit finalizer, a bijection that makes every bit of the result depend
+// on every bit of h. used to finish hashes and to derive a second hash from one
+static inline uint64_t h_mix64(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+// 64-bit FNV-1a hash, followed by the murmur3 finalizer so that the low bits used
+// for the bucket index depend on every char of s. default hash for h_table
+uint64_t h_fnv1a(const char *s, size_t n);
+// sum of the chars of s plus 6691, which is what hfunc uses. every anagram of s has
+// the same hash; only useful for comparisons with h_fnv1a
+uint64_t h_sum(const char *s, size_t n);
 // hash function for the table; not platform portable (int width platform
 // dependent). generates integer hash for given string and table size
 int hfunc(char *s, int siz);
-// insert a new string into the hash table
+// set the max load factor of the hash table; the table doubles its no. buckets when
+// it has more than lf nodes per bucket. lf = 0 keeps the no. buckets fixed
+void h_table_set_max_lf(h_table *ht, double lf);
+// add a blocked Bloom filter to the table, sized for n nodes (or the no. nodes in the
+// table, if more) with a false positive rate of about fp, or remove the filter if fp
+// is 0. each string sets bits in only one H_BLOOM_BLK bit block, so checking it costs
+// at most one cache miss. inserts add to the filter, and searches check it first, so
+// a search for a string that was never inserted usually returns 0 without touching a
+// bucket, and a counted insert of a new string skips its search of the chain. the
+// filter uses about 1.73 log2(1 / fp) bits per node for fp = 0.01, and 20% more for
+// each factor of 10 below that, and doubles in size (keeping its false positive
+// rate) when the table grows past n nodes
+void h_table_set_bloom(h_table *ht, size_t n, double fp);
+// returns 0 if the Bloom filter of the table shows that s was never inserted, else 1
+// (always 1 if the table has no filter)
+int h_table_maybe(h_table *ht, char *s);
+// insert a new string into the hash table. if a rehash is in progress, H_REHASH_N
+// buckets are moved to the new table first, so that no insert pays for moving all
+// the nodes at once. in counted mode, if s is already in the table, its count is
+// incremented instead of adding a node
 void h_table_insert(h_table *ht, char *s);
-// search for a string in the hash table; returns occurrences of s in the table
+// finish any rehash in progress at once
+void h_table_rehash(h_table *ht);
+// search for a string in the hash table; returns occurrences of s in the table. in
+// counted mode the search stops at the node holding s
 int h_table_nsearch(h_table *ht, char *s);
+// search for each of the n strings in keys, writing the no. occurrences of keys[i] in
+// the table to counts[i]. the strings are taken H_BATCH at a time: all of them are
+// hashed and their buckets prefetched, then their chains are walked one node of each
+// at a time, prefetching the next nodes, so that the cache misses of up to H_BATCH
+// searches overlap instead of following each other. finishes any rehash in progress
+// first
+void h_table_nsearch_batch(h_table *ht, char **keys, size_t n, int *counts);
+// print no. nodes and distinct strings, bucket occupancy, and a histogram of the no.
+// distinct strings per bucket to f. the no. buckets a uniform hash is expected to use
+// for that many distinct strings is printed next to the actual one. finishes any
+// rehash in progress first
+void h_table_stats(h_table *ht, FILE *f);
+// returns the no. bytes used by the table, its buckets (and those of the old table
+// during a rehash), nodes, and strings with their lengths, not counting malloc or
+// arena overhead
+size_t h_table_mem(h_table *ht);
 // free a hash table
 void free_h_table(h_table *ht);
 
@@ -19,11 +19,27 @@
  *
  * recommended compilation is using the Makefile provided in the directory and 
  * typing 'make strsea'. from the command line 'gcc -Wall -g -o strsea strsea.c 
- * strh_table.c strh_table.h' is the preferred build method.
+ * strh_table.c rx_tree.c d_alloc.c -lm' is the preferred build method.
  * please run by reading input file from stdin: './strsea < sparse_arrays_input01'
  *
+ * the hash table is in counted mode, so each distinct string is stored once with the
+ * no. times it was inserted, and its nodes and strings are allocated from arenas.
+ *
+ * run with --stats to also print the bucket occupancy and chain lengths of the hash
+ * table to stdout, next to those of a table using the old character sum hash, and the
+ * memory used by the hash table next to that used by a radix tree (rx_tree.h) of the
+ * same strings, which can also count the strings with a given prefix.
+ *
  * Changelog:
  *
+ * 10-17-2026
+ *
+ * added --stats flag. the hash table is now in counted mode. the input buffer is
+ * now freed. the hash table allocates from arenas, so d_alloc.c is needed to build.
+ * all the queries are read first and then searched for with h_table_nsearch_batch.
+ * --stats also builds a radix tree of the strings and prints its memory use next to
+ * the hash table's, so rx_tree.c is needed to build. strh_table.c now needs -lm
+ *
  * 09-20-2018
  *
  * edited file description and updated build information
@@ -39,11 +55,14 @@
 #include <stdlib.h>
 #include <string.h>
 #include "strh_table.h"
+#include "rx_tree.h"
 
 // program name "string search"
 #define PROGNAME "strsea"
 // default name of output file (not included in hackerrank original version)
 #define OUT_FILE "strsea_out"
+// flag to print hash table statistics
+#define STATS_FLAG "--stats"
 
 int main(int argc, char **argv)
 {
@@ -51,8 +70,14 @@ int main(int argc, char **argv)
     // get number of strings to insert into hash table, loop index
     int n, i;
     scanf("%d", &n);
-    // new hash table of size H_SIZ
-    h_table *ht = new_h_table(H_SIZ);
+    // whether to print hash table statistics
+    int stats = (argc > 1 && strcmp(argv[1], STATS_FLAG) == 0);
+    // new counted hash table of size H_SIZ, and one that uses h_sum if printing
+    // statistics
+    h_table *ht = new_h_table_hf(H_SIZ, h_fnv1a, H_COUNTED | H_ARENA);
+    h_table *ht_s = (stats) ? new_h_table_hf(H_SIZ, h_sum, H_COUNTED | H_ARENA) : NULL;
+    // radix tree of the same strings if printing statistics
+    rx_tree *rt = (stats) ? new_rx_tree() : NULL;
     // input buffer (BUFSIZ large enough for most small strings)
     char *buf = (char *) malloc(BUFSIZ * sizeof(char));
     // insert next n strings into hash table
@@ -62,24 +87,50 @@ int main(int argc, char **argv)
         scanf("%s", buf);
         // insert into hash table
         h_table_insert(ht, buf);
+        if (stats) {
+            h_table_insert(ht_s, buf);
+            rx_tree_insert(rt, buf);
+        }
         // clear buffer
         memset(buf, 0, strlen(buf) * sizeof(char));
     }
+    // print statistics for both hash functions
+    if (stats) {
+        printf("%s: h_fnv1a\n", PROGNAME);
+        h_table_stats(ht, stdout);
+        printf("%s: h_sum\n", PROGNAME);
+        h_table_stats(ht_s, stdout);
+        free_h_table(ht_s);
+        printf("%s: memory\nh_table: %lu bytes, rx_tree: %lu bytes (%lu nodes)\n",
+               PROGNAME, (unsigned long) h_table_mem(ht), (unsigned long) rt->mem,
+               (unsigned long) rt->n);
+        free_rx_tree(rt);
+    }
     // get number of query strings to search for
     scanf("%d", &n);
-    // search for these strings
+    // read in all the query strings, then search for them in one batch
+    char **qry = (char **) malloc(n * sizeof(char *));
+    int *cnt = (int *) malloc(n * sizeof(int));
     i = 0;
-    while (i++ < n) {
-        // read in string
+    while (i < n) {
+        // read in string and copy it
         scanf("%s", buf);
-        // search for it in hash table and print it and its number of occurrences
-	// in the hash table
-        fprintf(fptr, "%d %s\n", h_table_nsearch(ht, buf), buf);
+        qry[i] = (char *) malloc(strlen(buf) + 1);
+        strcpy(qry[i++], buf);
         // clear buffer
         memset(buf, 0, strlen(buf) * sizeof(char));
     }
-    // free hash table memory and close file
+    h_table_nsearch_batch(ht, qry, n, cnt);
+    // print each string and its number of occurrences in the hash table
+    for (i = 0; i < n; i++) {
+        fprintf(fptr, "%d %s\n", cnt[i], qry[i]);
+        free(qry[i]);
+    }
+    free(qry);
+    free(cnt);
+    // free hash table and buffer memory and close file
     free_h_table(ht);
+    free(buf);
     fclose(fptr);
     return 0;
 }
@@ -0,0 +1,80 @@
+/**
+ * strtopk.c
+ *
+ * main program that finds the most frequent strings of the same input as strsea.c,
+ * with the Space-Saving top-k counter in ss_table.c instead of a hash table of every
+ * distinct string. reads input from stdin: the no. strings n, then the n strings.
+ * anything after them, like the queries in the strsea input, is not read.
+ *
+ * prints the k most frequent strings to stdout, most frequent first, each with its
+ * count and the range its true count is in. a string is marked with '*' if it is
+ * certain to be among the k most frequent, which is when even the smallest count it
+ * could have is no less than the count of the string after the k-th. the memory used
+ * depends only on the no. counters m and the length of the strings, not on how many
+ * distinct strings there are.
+ *
+ * recommended compilation is using the Makefile provided in the directory and
+ * typing 'make strtopk'. from the command line 'gcc -Wall -g -o strtopk strtopk.c
+ * ss_table.c strh_table.c d_alloc.c -lm' is the preferred build method.
+ * please run by reading input file from stdin: './strtopk [k [m]] < input', where k
+ * is the no. strings to print (default STK_K) and m is the no. counters (default
+ * SS_M, and at least k + 1).
+ *
+ * Changelog:
+ *
+ * 10-17-2026
+ *
+ * initial creation
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ss_table.h"
+
+// program name "string top k"
+#define PROGNAME "strtopk"
+// default no. strings to print
+#define STK_K 10
+
+int main(int argc, char **argv)
+{
+    // no. strings to insert, loop index
+    int n, i;
+    // no. strings to print and no. counters
+    long k = (argc > 1) ? strtol(argv[1], NULL, 10) : STK_K;
+    long m = (argc > 2) ? strtol(argv[2], NULL, 10) : SS_M;
+    if (argc > 3 || k < 1 || m <= k) {
+        fprintf(stderr, "usage: %s [k [m]] < input, where 0 < k < m\n", PROGNAME);
+        return 1;
+    }
+    if (scanf("%d", &n) != 1) {
+        fprintf(stderr, "%s: no. strings expected\n", PROGNAME);
+        return 1;
+    }
+    ss_table *ss = new_ss_table((size_t) m);
+    // input buffer (BUFSIZ large enough for most small strings)
+    char *buf = (char *) malloc(BUFSIZ * sizeof(char));
+    // insert next n strings into the table
+    i = 0;
+    while (i++ < n && scanf("%s", buf) == 1) {
+        ss_table_insert(ss, buf);
+    }
+    // the k most frequent, and the one after them
+    ss_node **top = (ss_node **) malloc((k + 1) * sizeof(ss_node *));
+    size_t n_top = ss_table_top(ss, top, (size_t) k + 1);
+    int next = (n_top > (size_t) k) ? top[k]->cnt : ss_table_min(ss);
+    printf("%s: %lu strings, %ld counters (%lu bytes); strings not listed occur at "
+           "most %d times\n", PROGNAME, (unsigned long) ss->n, m,
+           (unsigned long) ss_table_mem(ss), next);
+    for (i = 0; i < (int) n_top && i < k; i++) {
+        printf("%d %s [%d, %d]%s\n", top[i]->cnt, top[i]->str,
+               top[i]->cnt - top[i]->err, top[i]->cnt,
+               (top[i]->cnt - top[i]->err >= next) ? " *" : "");
+    }
+    free(top);
+    free(buf);
+    free_ss_table(ss);
+    return 0;
+}